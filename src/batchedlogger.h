@@ -7,6 +7,10 @@
 
 #include <logging.h>
 
+/**
+ * Collects the lines of a multi-line log message and logs them as one message, so that they are neither interleaved
+ * with messages from other threads nor cost a LogPrintStr call (and a queued message with -logasync) per line.
+ */
 class CBatchedLogger
 {
 private:
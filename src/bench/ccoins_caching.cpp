@@ -5,6 +5,7 @@
 #include <bench/bench.h>
 #include <coins.h>
 #include <policy/policy.h>
+#include <random.h>
 #include <wallet/crypter.h>
 
 #include <vector>
@@ -85,4 +86,37 @@ static void CCoinsCaching(benchmark::Bench& bench)
     });
 }
 
+// Fill, partially spend and flush the coins cache like block connection during IBD does, mostly measuring the
+// allocation of the cache's map nodes
+static void CCoinsCacheFlush(benchmark::Bench& bench)
+{
+    constexpr size_t COINS_PER_ROUND = 10000;
+
+    FastRandomContext rand(true);
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(COINS_PER_ROUND);
+    for (size_t i = 0; i < COINS_PER_ROUND; i++) {
+        outpoints.emplace_back(rand.rand256(), 0);
+    }
+
+    CCoinsView coinsDummy;
+    CCoinsViewCache coins(&coinsDummy);
+    bench.batch(COINS_PER_ROUND).unit("coin").run([&] {
+        for (const auto& outpoint : outpoints) {
+            Coin coin;
+            coin.out.nValue = COIN;
+            coin.out.scriptPubKey.assign((uint32_t)25, 1);
+            coin.nHeight = 1;
+            coins.AddCoin(outpoint, std::move(coin), false);
+        }
+        for (size_t i = 0; i < outpoints.size(); i += 2) {
+            coins.SpendCoin(outpoints[i]);
+        }
+        coins.SetBestBlock(outpoints[0].hash);
+        coins.Flush();
+        coins.ReallocateCache();
+    });
+}
+
 BENCHMARK(CCoinsCaching);
+BENCHMARK(CCoinsCacheFlush);
@@ -0,0 +1,67 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <bench/bench.h>
+#include <evo/deterministicmns.h>
+#include <evo/simplifiedmns.h>
+#include <hash.h>
+#include <llmq/commitment.h>
+#include <netbase.h>
+#include <streams.h>
+#include <version.h>
+
+static CDeterministicMNCPtr CreateDMN(uint64_t internalId, uint16_t port)
+{
+    auto dmn = std::make_shared<CDeterministicMN>(internalId);
+    dmn->proTxHash = ArithToUint256(internalId + 1);
+    dmn->collateralOutpoint = COutPoint(dmn->proTxHash, 0);
+
+    auto state = std::make_shared<CDeterministicMNState>();
+    state->confirmedHash = dmn->proTxHash;
+    state->keyIDOwner = CKeyID(Hash160(dmn->proTxHash.begin(), dmn->proTxHash.end()));
+    state->keyIDVoting = state->keyIDOwner;
+    Lookup(strprintf("%d.%d.%d.%d", 1, (internalId >> 16) & 0xff, (internalId >> 8) & 0xff, internalId & 0xff).c_str(), state->addr, port, false);
+    dmn->pdmnState = state;
+    return dmn;
+}
+
+// Building and serializing the simplified MN list diffs is the bulk of the work done for each GETMNLISTDIFF and
+// each of the (at least) five diffs included in a QUORUMROTATIONINFO response
+static void EvoMnListDiff(benchmark::Bench& bench, size_t mnCount, size_t changedCount)
+{
+    assert(changedCount * 2 <= mnCount);
+    CDeterministicMNList from(uint256S("01"), 1, 0);
+    for (size_t i = 0; i < mnCount; i++) {
+        from.AddMN(CreateDMN(i, 9999));
+    }
+
+    CDeterministicMNList to = from;
+    to.SetBlockHash(uint256S("02"));
+    to.SetHeight(2);
+    for (size_t i = 0; i < changedCount; i++) {
+        // remove, update and add some masternodes
+        to.RemoveMN(ArithToUint256(i + 1));
+        auto dmn = from.GetMN(ArithToUint256(changedCount + i + 1));
+        auto newState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
+        newState->addr.SetPort(10000);
+        to.UpdateMN(*dmn, newState);
+        to.AddMN(CreateDMN(mnCount + i, 9999));
+    }
+
+    bench.minEpochIterations(10).run([&] {
+        auto diff = from.BuildSimplifiedDiff(to);
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << diff;
+        ankerl::nanobench::doNotOptimizeAway(ss.size());
+    });
+}
+
+static void EvoMnListDiff_1000_10(benchmark::Bench& bench) { EvoMnListDiff(bench, 1000, 10); }
+static void EvoMnListDiff_1000_500(benchmark::Bench& bench) { EvoMnListDiff(bench, 1000, 500); }
+static void EvoMnListDiff_4000_40(benchmark::Bench& bench) { EvoMnListDiff(bench, 4000, 40); }
+
+BENCHMARK(EvoMnListDiff_1000_10);
+BENCHMARK(EvoMnListDiff_1000_500);
+BENCHMARK(EvoMnListDiff_4000_40);
@@ -0,0 +1,28 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <logging.h>
+
+// Cost of a log message for the logging thread, written to debug.log in the benchmark's data directory
+static void Logging(benchmark::Bench& bench, bool fAsync, bool fDrop)
+{
+    if (fAsync) {
+        LogInstance().StartAsyncWriter(DEFAULT_LOGASYNCBUFFER, fDrop);
+    }
+    bench.run([&] {
+        LogPrintf("%s: block %s received from peer=%d\n", __func__, "000000000000001ad1d7ef5e1e5b7bd63e24e2a3c9e8b4de2dbd8e5e1f7f9c1a", 42);
+    });
+    if (fAsync) {
+        LogInstance().StopAsyncWriter();
+    }
+}
+
+static void LoggingSync(benchmark::Bench& bench) { Logging(bench, false, false); }
+static void LoggingAsync(benchmark::Bench& bench) { Logging(bench, true, false); }
+static void LoggingAsyncDrop(benchmark::Bench& bench) { Logging(bench, true, true); }
+
+BENCHMARK(LoggingSync);
+BENCHMARK(LoggingAsync);
+BENCHMARK(LoggingAsyncDrop);
@@ -15,12 +15,11 @@ static void AddTx(const CTransactionRef& tx, const CAmount& fee, CTxMemPool& poo
     pool.addUnchecked(CTxMemPoolEntry(tx, fee, /* time */ 0, /* height */ 1, /* spendsCoinbase */ false, /* sigOps */ 1, lp));
 }
 
-static void RpcMempool(benchmark::Bench& bench)
+static void FillMempool(CTxMemPool& pool, int count)
 {
-    CTxMemPool pool;
     LOCK2(cs_main, pool.cs);
 
-    for (int i = 0; i < 1000; ++i) {
+    for (int i = 0; i < count; ++i) {
         CMutableTransaction tx = CMutableTransaction();
         tx.vin.resize(1);
         tx.vin[0].scriptSig = CScript() << OP_1;
@@ -30,10 +29,44 @@ static void RpcMempool(benchmark::Bench& bench)
         const CTransactionRef tx_r{MakeTransactionRef(tx)};
         AddTx(tx_r, /* fee */ i, pool);
     }
+}
+
+static void RpcMempool(benchmark::Bench& bench)
+{
+    CTxMemPool pool;
+    FillMempool(pool, 1000);
 
+    // Like the RPC, build the result without holding cs_main or pool.cs, MempoolToJSON takes them itself
     bench.minEpochIterations(40).run([&] {
         (void)MempoolToJSON(pool, /*verbose*/ true);
     });
 }
 
+// Objects keyed by txid or proTxHash, like masternodelist or gobject list build them. pushKV checks
+// for an existing key in O(N), __pushKV appends in O(1) for callers which know the keys are unique.
+static void BuildTxidObject(benchmark::Bench& bench, bool unique)
+{
+    CTxMemPool pool;
+    FillMempool(pool, 2000);
+    std::vector<uint256> vtxid;
+    pool.queryHashes(vtxid);
+
+    bench.minEpochIterations(5).run([&] {
+        UniValue o(UniValue::VOBJ);
+        for (const uint256& hash : vtxid) {
+            if (unique) {
+                o.__pushKV(hash.ToString(), hash.GetUint64(0));
+            } else {
+                o.pushKV(hash.ToString(), hash.GetUint64(0));
+            }
+        }
+        ankerl::nanobench::doNotOptimizeAway(o.size());
+    });
+}
+
+static void RpcMempoolPushKV(benchmark::Bench& bench) { BuildTxidObject(bench, false); }
+static void RpcMempoolPushKVUnique(benchmark::Bench& bench) { BuildTxidObject(bench, true); }
+
 BENCHMARK(RpcMempool);
+BENCHMARK(RpcMempoolPushKV);
+BENCHMARK(RpcMempoolPushKVUnique);
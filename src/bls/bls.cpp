@@ -5,6 +5,8 @@
 #include <bls/bls.h>
 
 #include <random.h>
+#include <threadsafety.h>
+#include <unordered_lru_cache.h>
 
 #ifndef BUILD_BITCOIN_INTERNAL
 #include <support/allocators/mt_pooled_secure.h>
@@ -128,6 +130,50 @@ CBLSSignature CBLSSecretKey::Sign(const uint256& hash) const
     return sigRet;
 }
 
+static constexpr size_t BLS_PUBKEY_CACHE_SIZE = 20000;
+
+// Keys are hashes already, so any 64 bits of them make a good hash for the map
+struct BLSPublicKeyCacheHasher
+{
+    std::size_t operator()(const uint256& v) const { return v.GetCheapHash(); }
+};
+
+// StdMutex rather than Mutex, this is part of the consensus library which doesn't link sync.cpp
+static StdMutex cs_pubKeyCache;
+static unordered_lru_cache<uint256, bls::G1Element, BLSPublicKeyCacheHasher, BLS_PUBKEY_CACHE_SIZE> pubKeyCache GUARDED_BY(cs_pubKeyCache);
+
+bool CBLSPublicKey::SetByteVectorCached(const std::vector<uint8_t>& vecBytes)
+{
+    if (vecBytes.size() != SerSize) {
+        CBLSWrapper::SetByteVector(vecBytes);
+        return false;
+    }
+
+    // The same bytes decode to different points depending on the scheme
+    CHashWriter hw(SER_GETHASH, 0);
+    hw.write((const char*)vecBytes.data(), vecBytes.size());
+    hw << fLegacy;
+    const uint256 cacheKey = hw.GetHash();
+
+    {
+        StdLockGuard l(cs_pubKeyCache);
+        if (pubKeyCache.get(cacheKey, impl)) {
+            fValid = true;
+            cachedHash.SetNull();
+            return true;
+        }
+    }
+
+    CBLSWrapper::SetByteVector(vecBytes);
+    if (!fValid || !CheckMalleable(vecBytes)) {
+        return false;
+    }
+
+    StdLockGuard l(cs_pubKeyCache);
+    pubKeyCache.insert(cacheKey, impl);
+    return true;
+}
+
 void CBLSPublicKey::AggregateInsecure(const CBLSPublicKey& o)
 {
     assert(IsValid() && o.IsValid());
@@ -150,7 +150,7 @@ public:
             Reset();
             return false;
         }
-        SetByteVector(b);
+        static_cast<C*>(this)->SetByteVector(b);
         return IsValid();
     }
 
@@ -170,7 +170,7 @@ public:
     {
         std::vector<uint8_t> vecBytes(SerSize, 0);
         s.read((char*)vecBytes.data(), SerSize);
-        SetByteVector(vecBytes);
+        static_cast<C*>(this)->SetByteVector(vecBytes);
 
         if (checkMalleable && !CheckMalleable(vecBytes)) {
             throw std::ios_base::failure("malleable BLS object");
@@ -262,6 +262,11 @@ public:
     using CBLSWrapper::CBLSWrapper;
 
     CBLSPublicKey() = default;
+    // Hides the inherited constructor, which would decode through CBLSWrapper::SetByteVector and skip the cache
+    explicit CBLSPublicKey(const std::vector<unsigned char>& vecBytes, const bool fLegacyIn = fLegacyDefault) : CBLSWrapper(fLegacyIn)
+    {
+        SetByteVectorCached(vecBytes);
+    }
 
     void AggregateInsecure(const CBLSPublicKey& o);
     static CBLSPublicKey AggregateInsecure(const std::vector<CBLSPublicKey>& pks, bool fLegacy = fLegacyDefault);
@@ -269,6 +274,25 @@ public:
     bool PublicKeyShare(const std::vector<CBLSPublicKey>& mpk, const CBLSId& id);
     bool DHKeyExchange(const CBLSSecretKey& sk, const CBLSPublicKey& pk);
 
+    // Decoding a public key means decompressing a G1 point, which is expensive. Operator and quorum keys are received
+    // over and over again, so decoded keys are kept in a process-wide cache keyed by the hash of their encoding.
+    // CBLSWrapper dispatches SetHexStr() and deserialization here as well, so every byte vector goes through it.
+    void SetByteVector(const std::vector<uint8_t>& vecBytes) { SetByteVectorCached(vecBytes); }
+
+    template <typename Stream>
+    inline void Unserialize(Stream& s, bool checkMalleable = true)
+    {
+        std::vector<uint8_t> vecBytes(SerSize, 0);
+        s.read((char*)vecBytes.data(), SerSize);
+        // Only canonical encodings end up in the cache, so there is nothing to check for these
+        if (!SetByteVectorCached(vecBytes) && checkMalleable && !CheckMalleable(vecBytes)) {
+            throw std::ios_base::failure("malleable BLS object");
+        }
+    }
+
+private:
+    // Returns true if the key was decoded from a canonical encoding, either found in or added to the cache
+    bool SetByteVectorCached(const std::vector<uint8_t>& vecBytes);
 };
 
 class CBLSSignature : public CBLSWrapper<bls::G2Element, BLS_CURVE_SIG_SIZE, CBLSSignature>
@@ -12,7 +12,10 @@
 #include <evo/specialtx.h>
 
 #include <pubkey.h>
+#include <saltedhasher.h>
 #include <serialize.h>
+#include <sync.h>
+#include <unordered_lru_cache.h>
 #include <version.h>
 
 #include <base58.h>
@@ -186,10 +189,29 @@ void CSimplifiedMNListDiff::ToJson(UniValue& obj) const
     }
 }
 
+// Diffs only depend on the two blocks they are built for, so the same pairs requested over and over by SPV clients
+// (e.g. "last known block to tip" and the work blocks used by qrinfo) are answered from memory instead of rebuilding
+// both MN lists and re-reading the block from disk each time
+static constexpr size_t MNLISTDIFF_CACHE_SIZE = 32;
+static CCriticalSection cs_mnListDiffCache;
+// Entries are shared with the callers, so a hit doesn't copy the diff. The truncate threshold defaults to twice the
+// size, keep it at the size so the cache never holds more than MNLISTDIFF_CACHE_SIZE diffs.
+static unordered_lru_cache<uint256, std::shared_ptr<const CSimplifiedMNListDiff>, StaticSaltedHasher, MNLISTDIFF_CACHE_SIZE - 1, MNLISTDIFF_CACHE_SIZE - 1> mnListDiffCache GUARDED_BY(cs_mnListDiffCache);
+
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet)
+{
+    std::shared_ptr<const CSimplifiedMNListDiff> mnListDiff;
+    if (!BuildSimplifiedMNListDiff(baseBlockHash, blockHash, mnListDiff, errorRet)) {
+        return false;
+    }
+    mnListDiffRet = *mnListDiff;
+    return true;
+}
+
+bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, std::shared_ptr<const CSimplifiedMNListDiff>& mnListDiffRet, std::string& errorRet)
 {
     AssertLockHeld(cs_main);
-    mnListDiffRet = CSimplifiedMNListDiff();
+    mnListDiffRet = nullptr;
 
     const CBlockIndex* baseBlockIndex = ::ChainActive().Genesis();
     if (!baseBlockHash.IsNull()) {
@@ -215,18 +237,27 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
         return false;
     }
 
+    // Keyed by the hashes as requested, as a null base block hash must be echoed back as is (see below)
+    const uint256 cacheKey = ::SerializeHash(std::make_pair(baseBlockHash, blockHash));
+    {
+        LOCK(cs_mnListDiffCache);
+        if (mnListDiffCache.get(cacheKey, mnListDiffRet)) {
+            return true;
+        }
+    }
+
     LOCK(deterministicMNManager->cs);
 
     auto baseDmnList = deterministicMNManager->GetListForBlock(baseBlockIndex);
     auto dmnList = deterministicMNManager->GetListForBlock(blockIndex);
-    mnListDiffRet = baseDmnList.BuildSimplifiedDiff(dmnList);
+    auto mnListDiff = std::make_shared<CSimplifiedMNListDiff>(baseDmnList.BuildSimplifiedDiff(dmnList));
 
     // We need to return the value that was provided by the other peer as it otherwise won't be able to recognize the
     // response. This will usually be identical to the block found in baseBlockIndex. The only difference is when a
     // null block hash was provided to get the diff from the genesis block.
-    mnListDiffRet.baseBlockHash = baseBlockHash;
+    mnListDiff->baseBlockHash = baseBlockHash;
 
-    if (!mnListDiffRet.BuildQuorumsDiff(baseBlockIndex, blockIndex)) {
+    if (!mnListDiff->BuildQuorumsDiff(baseBlockIndex, blockIndex)) {
         errorRet = strprintf("failed to build quorums diff");
         return false;
     }
@@ -238,15 +269,20 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
         return false;
     }
 
-    mnListDiffRet.cbTx = block.vtx[0];
+    mnListDiff->cbTx = block.vtx[0];
 
     std::vector<uint256> vHashes;
+    vHashes.reserve(block.vtx.size());
     std::vector<bool> vMatch(block.vtx.size(), false);
     for (const auto& tx : block.vtx) {
         vHashes.emplace_back(tx->GetHash());
     }
     vMatch[0] = true; // only coinbase matches
-    mnListDiffRet.cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
+    mnListDiff->cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
+
+    mnListDiffRet = mnListDiff;
+    LOCK(cs_mnListDiffCache);
+    mnListDiffCache.insert(cacheKey, mnListDiffRet);
 
     return true;
 }
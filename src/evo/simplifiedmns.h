@@ -10,6 +10,8 @@
 #include <netaddress.h>
 #include <pubkey.h>
 
+#include <memory>
+
 class UniValue;
 class CBlockIndex;
 class CDeterministicMNList;
@@ -120,5 +122,7 @@ public:
 };
 
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet);
+//! Same as above, but shares the (possibly cached) diff instead of copying it
+bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, std::shared_ptr<const CSimplifiedMNListDiff>& mnListDiffRet, std::string& errorRet);
 
 #endif // BITCOIN_EVO_SIMPLIFIEDMNS_H
@@ -7,6 +7,7 @@
 #include <chainparams.h>
 #include <crypto/hmac_sha256.h>
 #include <httpserver.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <ui_interface.h>
@@ -16,6 +17,7 @@
 #include <walletinitinterface.h>
 
 #include <memory>
+#include <set>
 
 #include <boost/algorithm/string.hpp> // boost::trim
 
@@ -63,9 +65,20 @@ private:
 static std::string strRPCUserColonPass;
 /* Stored RPC timer interface (for unregistration) */
 static std::unique_ptr<HTTPRPCTimerInterface> httpRPCTimerInterface;
+/* JSON-RPC methods that are cheap enough to be served from the fast work queue */
+static std::set<std::string> g_rpc_fast_methods;
+/** Larger request bodies are never inspected for the fast work queue */
+static const size_t MAX_FAST_REQUEST_SIZE = 1024;
 
 static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const UniValue& id)
 {
+    if (req->IsReplyStarted()) {
+        // Part of a streamed result was already sent, all we can do is to cut the reply short
+        LogPrintf("%s: Error after the reply was started, truncating it: %s\n", __func__, objError.write());
+        req->WriteReplyEnd();
+        return;
+    }
+
     // Send error reply from json-rpc error object
     int nStatus = HTTP_INTERNAL_SERVER_ERROR;
     int code = find_value(objError, "code").get_int();
@@ -189,8 +202,27 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
         if (valRequest.isObject()) {
             jreq.parse(valRequest);
 
+            // Handlers with large results may stream them, the reply is then sent in chunks
+            // as soon as the first chunk of the result is available
+            JSONStreamWriter stream([req](const std::string& chunk) {
+                if (!req->IsReplyStarted()) {
+                    req->WriteHeader("Content-Type", "application/json");
+                    req->WriteReplyStart(HTTP_OK);
+                    req->WriteReplyChunk("{\"result\":");
+                }
+                req->WriteReplyChunk(chunk);
+            });
+            jreq.stream = &stream;
+
             UniValue result = tableRPC.execute(jreq);
 
+            if (stream.Used()) {
+                stream.Flush();
+                req->WriteReplyChunk(",\"error\":null,\"id\":" + jreq.id.write() + "}\n");
+                req->WriteReplyEnd();
+                return true;
+            }
+
             // Send reply
             strReply = JSONRPCReply(result, NullUniValue, jreq.id);
 
@@ -212,6 +244,23 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
     return true;
 }
 
+/** Send single calls of an allowlisted method to the fast work queue. Batches always go to the default one. */
+static HTTPWorkQueueClass HTTPReq_JSONRPC_Classify(HTTPRequest* req, const std::string &)
+{
+    if (g_rpc_fast_methods.empty() || req->GetRequestMethod() != HTTPRequest::POST) {
+        return HTTPWorkQueueClass::DEFAULT;
+    }
+    UniValue valRequest;
+    if (!valRequest.read(req->PeekBody(MAX_FAST_REQUEST_SIZE)) || !valRequest.isObject()) {
+        return HTTPWorkQueueClass::DEFAULT;
+    }
+    const UniValue& method = find_value(valRequest, "method");
+    if (method.isStr() && g_rpc_fast_methods.count(method.get_str())) {
+        return HTTPWorkQueueClass::FAST;
+    }
+    return HTTPWorkQueueClass::DEFAULT;
+}
+
 static bool InitRPCAuthentication()
 {
     if (gArgs.GetArg("-rpcpassword", "") == "")
@@ -240,9 +289,18 @@ bool StartHTTPRPC()
     if (!InitRPCAuthentication())
         return false;
 
-    RegisterHTTPHandler("/", true, HTTPReq_JSONRPC);
+    std::vector<std::string> fast_methods;
+    boost::split(fast_methods, gArgs.GetArg("-rpcfastmethods", DEFAULT_RPC_FAST_METHODS), boost::is_any_of(","));
+    g_rpc_fast_methods.clear();
+    for (const std::string& method : fast_methods) {
+        if (!method.empty()) {
+            g_rpc_fast_methods.insert(method);
+        }
+    }
+
+    RegisterHTTPHandler("/", true, HTTPReq_JSONRPC, HTTPReq_JSONRPC_Classify);
     if (g_wallet_init_interface.HasWalletSupport()) {
-        RegisterHTTPHandler("/wallet/", false, HTTPReq_JSONRPC);
+        RegisterHTTPHandler("/wallet/", false, HTTPReq_JSONRPC, HTTPReq_JSONRPC_Classify);
     }
     struct event_base* eventBase = EventBase();
     assert(eventBase);
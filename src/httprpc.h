@@ -5,6 +5,10 @@
 #ifndef BITCOIN_HTTPRPC_H
 #define BITCOIN_HTTPRPC_H
 
+#include <string>
+
+/** JSON-RPC methods served from the fast HTTP work queue by default */
+static const std::string DEFAULT_RPC_FAST_METHODS = "getbestblockhash,getblockcount,getblockhash,getconnectioncount,getrpcinfo,getrpcstats,uptime";
 
 /** Start HTTP RPC subsystem.
  * Precondition; HTTP and RPC has been started.
@@ -15,6 +15,7 @@
 #include <util/threadnames.h>
 #include <util/translation.h>
 
+#include <atomic>
 #include <deque>
 #include <stdio.h>
 #include <string>
@@ -42,6 +43,51 @@
 /** Maximum size of http request (request line + headers) */
 static const size_t MAX_HEADERS_SIZE = 8192;
 
+/** Maximum size of a chunked reply waiting to be sent to the client before WriteReplyChunk blocks */
+static const size_t MAX_REPLY_BUFFERED = 1024 * 1024;
+
+/**
+ * Flow control of a chunked reply. The event loop thread keeps track of the
+ * connection's output buffer, the worker thread writing the reply waits on
+ * it until the client received enough of the reply.
+ */
+struct HTTPReplyFlow
+{
+    Mutex cs;
+    std::condition_variable cond;
+    //! Size of the chunks handed to the event loop which were not added to the output buffer yet
+    size_t queued GUARDED_BY(cs){0};
+    //! Size of the connection's output buffer
+    size_t buffered GUARDED_BY(cs){0};
+    //! Whether the connection was closed, the request is freed then
+    bool closed GUARDED_BY(cs){false};
+
+    // Only used on the event loop thread
+    struct evhttp_connection* conn{nullptr};
+    struct evbuffer* output{nullptr};
+    struct evbuffer_cb_entry* output_cb{nullptr};
+};
+
+static void http_reply_output_cb(struct evbuffer* buffer, const struct evbuffer_cb_info* info, void* arg)
+{
+    HTTPReplyFlow* flow = static_cast<HTTPReplyFlow*>(arg);
+    {
+        LOCK(flow->cs);
+        flow->buffered = info->orig_size + info->n_added - info->n_deleted;
+    }
+    flow->cond.notify_all();
+}
+
+static void http_reply_close_cb(struct evhttp_connection* conn, void* arg)
+{
+    HTTPReplyFlow* flow = static_cast<HTTPReplyFlow*>(arg);
+    flow->conn = nullptr;
+    flow->output = nullptr;
+    flow->output_cb = nullptr;
+    WITH_LOCK(flow->cs, flow->closed = true);
+    flow->cond.notify_all();
+}
+
 /** HTTP request work item */
 class HTTPWorkItem final : public HTTPClosure
 {
@@ -62,6 +108,20 @@ private:
     HTTPRequestHandler func;
 };
 
+/** Work queue statistics, kept outside of the queue so they can be read at any time */
+struct WorkQueueCounters
+{
+    std::atomic<size_t> depth{0};
+    std::atomic<size_t> max_depth{0};
+    std::atomic<uint64_t> rejected{0};
+};
+static WorkQueueCounters g_work_queue_stats[2];
+
+static WorkQueueCounters& GetWorkQueueCounters(HTTPWorkQueueClass queue_class)
+{
+    return g_work_queue_stats[queue_class == HTTPWorkQueueClass::FAST ? 1 : 0];
+}
+
 /** Simple work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
  */
@@ -74,11 +134,14 @@ private:
     std::deque<std::unique_ptr<WorkItem>> queue GUARDED_BY(cs);
     bool running GUARDED_BY(cs);
     const size_t maxDepth;
+    WorkQueueCounters& stats;
 
 public:
-    explicit WorkQueue(size_t _maxDepth) : running(true),
-                                 maxDepth(_maxDepth)
+    WorkQueue(size_t _maxDepth, WorkQueueCounters& _stats) : running(true),
+                                 maxDepth(_maxDepth),
+                                 stats(_stats)
     {
+        stats.max_depth = maxDepth;
     }
     /** Precondition: worker threads have all stopped (they have been joined).
      */
@@ -93,6 +156,7 @@ public:
             return false;
         }
         queue.emplace_back(std::unique_ptr<WorkItem>(item));
+        stats.depth = queue.size();
         cond.notify_one();
         return true;
     }
@@ -109,6 +173,7 @@ public:
                     break;
                 i = std::move(queue.front());
                 queue.pop_front();
+                stats.depth = queue.size();
             }
             (*i)();
         }
@@ -124,13 +189,14 @@ public:
 
 struct HTTPPathHandler
 {
-    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler):
-        prefix(_prefix), exactMatch(_exactMatch), handler(_handler)
+    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler, HTTPRequestClassifier _classifier):
+        prefix(_prefix), exactMatch(_exactMatch), handler(_handler), classifier(_classifier)
     {
     }
     std::string prefix;
     bool exactMatch;
     HTTPRequestHandler handler;
+    HTTPRequestClassifier classifier;
 };
 
 /** HTTP module state */
@@ -143,6 +209,8 @@ static struct evhttp* eventHTTP = nullptr;
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
 static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
+//! Work queue for cheap requests, so they are not stuck behind slow ones (null if disabled)
+static std::unique_ptr<WorkQueue<HTTPClosure>> g_fast_work_queue{nullptr};
 //! Handlers for (sub)paths
 static std::vector<HTTPPathHandler> pathHandlers;
 //! Bound listening sockets
@@ -261,12 +329,19 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
 
     // Dispatch to worker thread
     if (i != iend) {
+        HTTPWorkQueueClass queue_class = HTTPWorkQueueClass::DEFAULT;
+        if (g_fast_work_queue && i->classifier) {
+            queue_class = i->classifier(hreq.get(), path);
+        }
+        WorkQueue<HTTPClosure>* queue = queue_class == HTTPWorkQueueClass::FAST ? g_fast_work_queue.get() : g_work_queue.get();
         auto item{std::make_unique<HTTPWorkItem>(std::move(hreq), path, i->handler)};
-        assert(g_work_queue);
-        if (g_work_queue->Enqueue(item.get())) {
+        assert(queue);
+        if (queue->Enqueue(item.get())) {
             item.release(); /* if true, queue took ownership */
         } else {
-            LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
+            ++GetWorkQueueCounters(queue_class).rejected;
+            LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the %s= setting\n",
+                      queue_class == HTTPWorkQueueClass::FAST ? "-rpcfastworkqueue" : "-rpcworkqueue");
             item->req->WriteReply(HTTP_INTERNAL_SERVER_ERROR, "Work queue depth exceeded");
         }
     } else {
@@ -338,9 +413,9 @@ static bool HTTPBindAddresses(struct evhttp* http)
 }
 
 /** Simple wrapper to set thread name and run work queue */
-static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num)
+static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, const char* name, int worker_num)
 {
-    util::ThreadRename(strprintf("httpworker.%i", worker_num));
+    util::ThreadRename(strprintf("%s.%i", name, worker_num));
     queue->Run();
 }
 
@@ -402,7 +477,12 @@ bool InitHTTPServer()
     int workQueueDepth = std::max((long)gArgs.GetArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1L);
     LogPrintf("HTTP: creating work queue of depth %d\n", workQueueDepth);
 
-    g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth, GetWorkQueueCounters(HTTPWorkQueueClass::DEFAULT));
+    if (gArgs.GetArg("-rpcfastthreads", DEFAULT_HTTP_FAST_THREADS) > 0) {
+        int fastWorkQueueDepth = std::max((long)gArgs.GetArg("-rpcfastworkqueue", DEFAULT_HTTP_FAST_WORKQUEUE), 1L);
+        LogPrintf("HTTP: creating fast work queue of depth %d\n", fastWorkQueueDepth);
+        g_fast_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(fastWorkQueueDepth, GetWorkQueueCounters(HTTPWorkQueueClass::FAST));
+    }
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -434,7 +514,14 @@ void StartHTTPServer()
     threadHTTP = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
-        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i);
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), "httpworker", i);
+    }
+    if (g_fast_work_queue) {
+        int fastThreads = gArgs.GetArg("-rpcfastthreads", DEFAULT_HTTP_FAST_THREADS);
+        LogPrintf("HTTP: starting %d fast worker threads\n", fastThreads);
+        for (int i = 0; i < fastThreads; i++) {
+            g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_fast_work_queue.get(), "httpfast", i);
+        }
     }
 }
 
@@ -448,6 +535,9 @@ void InterruptHTTPServer()
     if (g_work_queue) {
         g_work_queue->Interrupt();
     }
+    if (g_fast_work_queue) {
+        g_fast_work_queue->Interrupt();
+    }
 }
 
 void StopHTTPServer()
@@ -479,6 +569,7 @@ void StopHTTPServer()
         eventBase = nullptr;
     }
     g_work_queue.reset();
+    g_fast_work_queue.reset();
     LogPrint(BCLog::HTTP, "Stopped HTTP server\n");
 }
 
@@ -514,12 +605,17 @@ void HTTPEvent::trigger(struct timeval* tv)
         evtimer_add(ev, tv); // trigger after timeval passed
 }
 HTTPRequest::HTTPRequest(struct evhttp_request* _req) : req(_req),
-                                                       replySent(false)
+                                                       replySent(false),
+                                                       replyStarted(false)
 {
 }
 HTTPRequest::~HTTPRequest()
 {
-    if (!replySent) {
+    if (replyStarted) {
+        // A chunked reply was interrupted, the client will see a truncated body
+        LogPrintf("%s: Unfinished chunked reply\n", __func__);
+        WriteReplyEnd();
+    } else if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
         WriteReply(HTTP_INTERNAL_SERVER_ERROR, "Unhandled request");
@@ -558,6 +654,20 @@ std::string HTTPRequest::ReadBody()
     return rv;
 }
 
+std::string HTTPRequest::PeekBody(size_t max_size) const
+{
+    struct evbuffer* buf = evhttp_request_get_input_buffer(req);
+    if (!buf)
+        return "";
+    size_t size = evbuffer_get_length(buf);
+    if (size == 0 || size > max_size)
+        return "";
+    std::string rv(size, '\0');
+    if (evbuffer_copyout(buf, &rv[0], size) != (ev_ssize_t)size)
+        return "";
+    return rv;
+}
+
 void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
 {
     struct evkeyvalq* headers = evhttp_request_get_output_headers(req);
@@ -572,7 +682,7 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
  */
 void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
 {
-    assert(!replySent && req);
+    assert(!replySent && !replyStarted && req);
     if (ShutdownRequested()) {
         WriteHeader("Connection", "close");
     }
@@ -600,6 +710,111 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     req = nullptr; // transferred back to main thread
 }
 
+void HTTPRequest::WriteReplyStart(int nStatus)
+{
+    assert(!replySent && !replyStarted && req);
+    if (ShutdownRequested()) {
+        WriteHeader("Connection", "close");
+    }
+    auto req_copy = req;
+    auto flow = replyFlow = std::make_shared<HTTPReplyFlow>();
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus, flow]{
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+        // Watch the output buffer and the connection, until WriteReplyEnd
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        bufferevent* bev = conn ? evhttp_connection_get_bufferevent(conn) : nullptr;
+        if (!bev) {
+            return;
+        }
+        flow->conn = conn;
+        flow->output = bufferevent_get_output(bev);
+        flow->output_cb = evbuffer_add_cb(flow->output, http_reply_output_cb, flow.get());
+        evhttp_connection_set_closecb(conn, http_reply_close_cb, flow.get());
+        WITH_LOCK(flow->cs, flow->buffered = evbuffer_get_length(flow->output));
+    });
+    ev->trigger(nullptr);
+    replyStarted = true;
+}
+
+void HTTPRequest::WriteReplyChunk(const std::string& strChunk)
+{
+    assert(replyStarted && req);
+    if (strChunk.empty()) {
+        // An empty chunk would terminate the chunked encoding
+        return;
+    }
+    {
+        // Wait until the client received enough of the reply, recheck for shutdown regularly
+        WAIT_LOCK(replyFlow->cs, lock);
+        while (!replyFlow->closed && replyFlow->queued + replyFlow->buffered >= MAX_REPLY_BUFFERED && !ShutdownRequested()) {
+            replyFlow->cond.wait_for(lock, std::chrono::milliseconds{100});
+        }
+        if (replyFlow->closed) {
+            // Nobody to send the reply to anymore
+            return;
+        }
+        replyFlow->queued += strChunk.size();
+    }
+    // The chunk is handed over in its own buffer, which is freed by the main http thread once it was queued
+    struct evbuffer* evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, strChunk.data(), strChunk.size());
+    auto req_copy = req;
+    auto flow = replyFlow;
+    const size_t size = strChunk.size();
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, evb, flow, size]{
+        if (!WITH_LOCK(flow->cs, return flow->closed)) {
+            evhttp_send_reply_chunk(req_copy, evb);
+        }
+        evbuffer_free(evb);
+        WITH_LOCK(flow->cs, flow->queued -= size);
+    });
+    ev->trigger(nullptr);
+}
+
+void HTTPRequest::WriteReplyEnd()
+{
+    assert(replyStarted && req);
+    auto req_copy = req;
+    auto flow = replyFlow;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, flow]{
+        if (WITH_LOCK(flow->cs, return flow->closed)) {
+            return;
+        }
+        if (flow->output_cb) {
+            evbuffer_remove_cb_entry(flow->output, flow->output_cb);
+        }
+        if (flow->conn) {
+            evhttp_connection_set_closecb(flow->conn, nullptr, nullptr);
+        }
+        evhttp_send_reply_end(req_copy);
+        // Re-enable reading from the socket, see WriteReply
+        if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02020001) {
+            evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+            if (conn) {
+                bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+                if (bev) {
+                    bufferevent_enable(bev, EV_READ | EV_WRITE);
+                }
+            }
+        }
+    });
+    ev->trigger(nullptr);
+    replyStarted = false;
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
+HTTPWorkQueueStats GetHTTPWorkQueueStats(HTTPWorkQueueClass queue_class)
+{
+    const WorkQueueCounters& counters = GetWorkQueueCounters(queue_class);
+    HTTPWorkQueueStats stats;
+    stats.depth = counters.depth;
+    stats.max_depth = counters.max_depth;
+    stats.rejected = counters.rejected;
+    return stats;
+}
+
 CService HTTPRequest::GetPeer() const
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
@@ -640,10 +855,10 @@ HTTPRequest::RequestMethod HTTPRequest::GetRequestMethod() const
     }
 }
 
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler)
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier &classifier)
 {
     LogPrint(BCLog::HTTP, "Registering HTTP handler for %s (exactmatch %d)\n", prefix, exactMatch);
-    pathHandlers.push_back(HTTPPathHandler(prefix, exactMatch, handler));
+    pathHandlers.push_back(HTTPPathHandler(prefix, exactMatch, handler, classifier));
 }
 
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch)
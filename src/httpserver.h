@@ -5,12 +5,16 @@
 #ifndef BITCOIN_HTTPSERVER_H
 #define BITCOIN_HTTPSERVER_H
 
+#include <stdint.h>
 #include <string>
 #include <functional>
+#include <memory>
 
 static const int DEFAULT_HTTP_THREADS=4;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
+static const int DEFAULT_HTTP_FAST_THREADS=1;
+static const int DEFAULT_HTTP_FAST_WORKQUEUE=16;
 
 struct evhttp_request;
 struct event_base;
@@ -35,13 +39,33 @@ void StopHTTPServer();
  * libevent doesn't support debug logging.*/
 bool UpdateHTTPServerLogging(bool enable);
 
+/** Work queues HTTP requests can be dispatched to, each with its own worker threads and depth limit */
+enum class HTTPWorkQueueClass {
+    DEFAULT,
+    FAST, //!< Cheap requests that should not wait behind slow ones
+};
+
+/** Statistics of the queue of HTTP requests waiting for a worker thread */
+struct HTTPWorkQueueStats
+{
+    size_t depth{0};
+    size_t max_depth{0};
+    /** Requests rejected because the queue was full */
+    uint64_t rejected{0};
+};
+HTTPWorkQueueStats GetHTTPWorkQueueStats(HTTPWorkQueueClass queue_class = HTTPWorkQueueClass::DEFAULT);
+
 /** Handler for requests to a certain HTTP path */
 typedef std::function<bool(HTTPRequest* req, const std::string &)> HTTPRequestHandler;
+/** Picks the work queue for a request to a certain HTTP path.
+ * Runs on the event loop thread, so it must be cheap and must not consume the body.
+ */
+typedef std::function<HTTPWorkQueueClass(HTTPRequest* req, const std::string &)> HTTPRequestClassifier;
 /** Register handler for prefix.
  * If multiple handlers match a prefix, the first-registered one will
- * be invoked.
+ * be invoked. Without a classifier all requests go to the default work queue.
  */
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler);
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier &classifier = nullptr);
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
 
@@ -50,6 +74,8 @@ void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
  */
 struct event_base* EventBase();
 
+struct HTTPReplyFlow;
+
 /** In-flight HTTP request.
  * Thin C++ wrapper around evhttp_request.
  */
@@ -58,6 +84,9 @@ class HTTPRequest
 private:
     struct evhttp_request* req;
     bool replySent;
+    bool replyStarted;
+    //! Flow control of a chunked reply
+    std::shared_ptr<HTTPReplyFlow> replyFlow;
 
 public:
     explicit HTTPRequest(struct evhttp_request* req);
@@ -97,6 +126,12 @@ public:
      */
     std::string ReadBody();
 
+    /**
+     * Return a copy of the request body without consuming it.
+     * Returns an empty string if the body is larger than max_size.
+     */
+    std::string PeekBody(size_t max_size) const;
+
     /**
      * Write output header.
      *
@@ -113,6 +148,36 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+
+    /**
+     * Start a chunked HTTP reply.
+     * The body is then sent with any number of WriteReplyChunk calls and
+     * completed with WriteReplyEnd, so that large replies never need to be
+     * built in memory as a whole.
+     *
+     * @note Headers must be written before calling this. WriteReply can not be
+     * used once a chunked reply was started.
+     */
+    void WriteReplyStart(int nStatus);
+
+    /**
+     * Send a part of the body of a chunked HTTP reply.
+     *
+     * @note Blocks while too much of the reply is waiting to be sent to the
+     * client, so that a slow client doesn't make the reply pile up in memory.
+     */
+    void WriteReplyChunk(const std::string& strChunk);
+
+    /**
+     * Complete a chunked HTTP reply.
+     *
+     * @note As this will give the request back to the main thread, do not call
+     * any other HTTPRequest methods after calling this.
+     */
+    void WriteReplyEnd();
+
+    /** Whether a chunked reply was started and not completed yet. */
+    bool IsReplyStarted() const { return replyStarted; }
 };
 
 /** Event handler closure.
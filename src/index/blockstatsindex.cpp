@@ -0,0 +1,72 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/blockstatsindex.h>
+#include <undo.h>
+#include <util/system.h>
+#include <validation.h>
+
+constexpr char DB_BLOCK_STATS = 's';
+
+std::unique_ptr<BlockStatsIndex> g_blockstatsindex;
+
+/** Access to the block stats index database (indexes/blockstats/) */
+class BlockStatsIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    bool ReadStats(const uint256& block_hash, BlockStats& stats) const;
+    bool WriteStats(const uint256& block_hash, const BlockStats& stats);
+};
+
+BlockStatsIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(GetDataDir() / "indexes" / "blockstats", n_cache_size, f_memory, f_wipe)
+{}
+
+bool BlockStatsIndex::DB::ReadStats(const uint256& block_hash, BlockStats& stats) const
+{
+    return Read(std::make_pair(DB_BLOCK_STATS, block_hash), stats);
+}
+
+bool BlockStatsIndex::DB::WriteStats(const uint256& block_hash, const BlockStats& stats)
+{
+    return Write(std::make_pair(DB_BLOCK_STATS, block_hash), stats);
+}
+
+BlockStatsIndex::BlockStatsIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+    : m_db(MakeUnique<BlockStatsIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+BlockStatsIndex::~BlockStatsIndex() {}
+
+bool BlockStatsIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    // The genesis block has no undo data, but also spends nothing
+    CBlockUndo block_undo;
+    if (pindex->nHeight > 0 && !UndoReadFromDisk(block_undo, pindex)) {
+        return error("%s: failed to read undo data of block %s", __func__, pindex->GetBlockHash().ToString());
+    }
+
+    BlockStats stats;
+    const auto lookup_prevout = [&block_undo](size_t n_tx, size_t n_in, CTxOut& prevout) {
+        // vtxundo skips the coinbase
+        if (n_tx == 0 || n_tx > block_undo.vtxundo.size() || n_in >= block_undo.vtxundo[n_tx - 1].vprevout.size()) {
+            return false;
+        }
+        prevout = block_undo.vtxundo[n_tx - 1].vprevout[n_in].out;
+        return true;
+    };
+    if (!ComputeBlockStats(block, lookup_prevout, stats)) {
+        return error("%s: undo data of block %s does not match its inputs", __func__, pindex->GetBlockHash().ToString());
+    }
+    return m_db->WriteStats(pindex->GetBlockHash(), stats);
+}
+
+BaseIndex::DB& BlockStatsIndex::GetDB() const { return *m_db; }
+
+bool BlockStatsIndex::LookupStats(const CBlockIndex* pindex, BlockStats& stats) const
+{
+    return m_db->ReadStats(pindex->GetBlockHash(), stats);
+}
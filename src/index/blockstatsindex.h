@@ -0,0 +1,48 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_BLOCKSTATSINDEX_H
+#define BITCOIN_INDEX_BLOCKSTATSINDEX_H
+
+#include <chain.h>
+#include <index/base.h>
+#include <node/blockstats.h>
+
+static const bool DEFAULT_BLOCKSTATSINDEX = false;
+
+/**
+ * BlockStatsIndex stores the precomputed getblockstats statistics of each block, including the fee stats
+ * which otherwise need the spent outputs of every input. The index is written to a LevelDB database and
+ * keyed by block hash, so entries of blocks that were disconnected stay valid.
+ */
+class BlockStatsIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+protected:
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "blockstatsindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit BlockStatsIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~BlockStatsIndex() override;
+
+    /// Look up the statistics of a block. Returns false if the block was not indexed (yet).
+    bool LookupStats(const CBlockIndex* pindex, BlockStats& stats) const;
+};
+
+/// The global block stats index, used in getblockstats. May be null.
+extern std::unique_ptr<BlockStatsIndex> g_blockstatsindex;
+
+#endif // BITCOIN_INDEX_BLOCKSTATSINDEX_H
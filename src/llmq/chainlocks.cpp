@@ -14,6 +14,7 @@
 #include <net_processing.h>
 #include <scheduler.h>
 #include <spork.h>
+#include <statsd_client.h>
 #include <txmempool.h>
 #include <ui_interface.h>
 #include <util/validation.h>
@@ -41,7 +42,8 @@ void CChainLocksHandler::Start()
     scheduler->scheduleEvery([&]() {
         CheckActiveState();
         EnforceBestChainLock();
-        // regularly retry signing the current chaintip as it might have failed before due to missing islocks
+        // Signing is triggered by new tips and islocks (see UpdatedBlockTip and NotifyTransactionLock), this is
+        // only a fallback for state changes which don't emit events, e.g. finishing blockchain sync
         TrySignChainTip();
     }, 5000);
 }
@@ -84,6 +86,15 @@ void CChainLocksHandler::ProcessMessage(CNode* pfrom, const std::string& msg_typ
     }
 
     if (msg_type == NetMsgType::CLSIG) {
+        // Most CLSIGs we receive are ones we've seen already from other peers. The hash of the raw message matches
+        // the one of the deserialized object, so check for these before decoding the signature.
+        const uint256 rawHash = Hash(vRecv.begin(), vRecv.end());
+        if (WITH_LOCK(cs, return seenChainLocks.count(rawHash) != 0)) {
+            LOCK(cs_main);
+            EraseObjectRequest(pfrom->GetId(), CInv(MSG_CLSIG, rawHash));
+            return;
+        }
+
         CChainLockSig clsig;
         vRecv >> clsig;
 
@@ -130,6 +141,16 @@ void CChainLocksHandler::ProcessNewChainLock(const NodeId from, const llmq::CCha
         LOCK(cs);
         bestChainLockHash = hash;
         bestChainLock = clsig;
+        ++stats.nChainLocksProcessed;
+
+        if (auto it = blockConnectedTime.find(clsig.blockHash); it != blockConnectedTime.end()) {
+            const int64_t nLatency = GetTimeMillis() - it->second;
+            stats.nLastBlockToChainLockMs = nLatency;
+            stats.nMaxBlockToChainLockMs = std::max(stats.nMaxBlockToChainLockMs, nLatency);
+            stats.nTotalBlockToChainLockMs += nLatency;
+            ++stats.nBlockToChainLockSamples;
+            statsClient.timing("chainlocks.blockToChainLock_ms", nLatency, 1.0f);
+        }
 
         if (pindex != nullptr) {
 
@@ -191,6 +212,31 @@ void CChainLocksHandler::AcceptedBlockHeader(const CBlockIndex* pindexNew)
 
 void CChainLocksHandler::UpdatedBlockTip()
 {
+    ScheduleTrySignChainTip(0);
+}
+
+void CChainLocksHandler::ScheduleTrySignChainTip(int64_t nDelayMs)
+{
+    if (nDelayMs > 0) {
+        // Delayed retry, used when the tip is only waiting for some TXs to become old enough. Only the earliest
+        // pending retry is acted upon, new tips and islocks trigger an immediate attempt anyway. A retry which is
+        // superseded by an earlier one does nothing when it fires.
+        const int64_t nDeadline = GetTimeMillis() + nDelayMs;
+        int64_t nCurrent = tryLockChainTipRetryDeadline;
+        do {
+            if (nCurrent != 0 && nCurrent <= nDeadline) {
+                return;
+            }
+        } while (!tryLockChainTipRetryDeadline.compare_exchange_weak(nCurrent, nDeadline));
+        scheduler->scheduleFromNow([this, nDeadline]() {
+            int64_t nExpected = nDeadline;
+            if (tryLockChainTipRetryDeadline.compare_exchange_strong(nExpected, 0)) {
+                ScheduleTrySignChainTip(0);
+            }
+        }, nDelayMs);
+        return;
+    }
+
     // don't call TrySignChainTip directly but instead let the scheduler call it. This way we ensure that cs_main is
     // never locked and TrySignChainTip is not called twice in parallel. Also avoids recursive calls due to
     // EnforceBestChainLock switching chains.
@@ -281,11 +327,15 @@ void CChainLocksHandler::TrySignChainTip()
 
     LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- trying to sign %s, height=%d\n", __func__, pindex->GetBlockHash().ToString(), pindex->nHeight);
 
+    WITH_LOCK(cs, ++stats.nSignAttempts);
+
     // When the new IX system is activated, we only try to ChainLock blocks which include safe transactions. A TX is
     // considered safe when it is islocked or at least known since 10 minutes (from mempool or block). These checks are
     // performed for the tip (which we try to sign) and the previous 5 blocks. If a ChainLocked block is found on the
     // way down, we consider all TXs to be safe.
     if (IsInstantSendEnabled() && RejectConflictingBlocks()) {
+        // smallest amount of time (in seconds) after which one of the blocking TXs becomes old enough, -1 if none
+        int64_t nMinWait{-1};
         auto pindexWalk = pindex;
         while (pindexWalk) {
             if (pindex->nHeight - pindexWalk->nHeight > 5) {
@@ -300,13 +350,14 @@ void CChainLocksHandler::TrySignChainTip()
                 break;
             }
 
-            auto txids = GetBlockTxs(pindexWalk->GetBlockHash());
+            // only TXs which were not safe the last time we looked are left in here
+            const auto txids = GetBlockUnlockedTxs(pindexWalk->GetBlockHash());
             if (!txids) {
                 pindexWalk = pindexWalk->pprev;
                 continue;
             }
 
-            for (auto& txid : *txids) {
+            for (const auto& txid : *txids) {
                 int64_t txAge = 0;
                 {
                     LOCK(cs);
@@ -316,15 +367,30 @@ void CChainLocksHandler::TrySignChainTip()
                     }
                 }
 
-                if (txAge < WAIT_FOR_ISLOCK_TIMEOUT && !quorumInstantSendManager->IsLocked(txid)) {
-                    LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- not signing block %s due to TX %s not being islocked and not old enough. age=%d\n", __func__,
-                              pindexWalk->GetBlockHash().ToString(), txid.ToString(), txAge);
-                    return;
+                // the islock might have arrived before we started tracking the block, or the TX got old enough
+                if (txAge >= WAIT_FOR_ISLOCK_TIMEOUT || quorumInstantSendManager->IsLocked(txid)) {
+                    LOCK(cs);
+                    RemoveUnlockedTx(txid);
+                    continue;
                 }
+
+                LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- not signing block %s due to TX %s not being islocked and not old enough. age=%d\n", __func__,
+                          pindexWalk->GetBlockHash().ToString(), txid.ToString(), txAge);
+                const int64_t nWait = WAIT_FOR_ISLOCK_TIMEOUT - txAge;
+                nMinWait = nMinWait == -1 ? nWait : std::min(nMinWait, nWait);
             }
 
             pindexWalk = pindexWalk->pprev;
         }
+
+        if (nMinWait != -1) {
+            WITH_LOCK(cs, ++stats.nSignAttemptsWaiting);
+            statsClient.inc("chainlocks.waitForIsLocks", 1.0f);
+            // NotifyTransactionLock retries as soon as the missing islocks arrive, make sure we also retry in time
+            // if they never do
+            ScheduleTrySignChainTip(nMinWait * 1000);
+            return;
+        }
     }
 
     uint256 requestId = ::SerializeHash(std::make_pair(CLSIG_REQUESTID_PREFIX, pindex->nHeight));
@@ -339,6 +405,12 @@ void CChainLocksHandler::TrySignChainTip()
         lastSignedHeight = pindex->nHeight;
         lastSignedRequestId = requestId;
         lastSignedMsgHash = msgHash;
+
+        ++stats.nSignRequests;
+        if (auto it = blockConnectedTime.find(msgHash); it != blockConnectedTime.end()) {
+            stats.nLastBlockToSignMs = GetTimeMillis() - it->second;
+            statsClient.timing("chainlocks.blockToSign_ms", stats.nLastBlockToSignMs, 1.0f);
+        }
     }
 
     quorumSigningManager->AsyncSignIfMember(Params().GetConsensus().llmqTypeChainLocks, requestId, msgHash);
@@ -354,6 +426,15 @@ void CChainLocksHandler::TransactionAddedToMempool(const CTransactionRef& tx, in
     txFirstSeenTime.emplace(tx->GetHash(), nAcceptTime);
 }
 
+void CChainLocksHandler::NotifyTransactionLock(const CTransactionRef& tx)
+{
+    bool fUpdated = WITH_LOCK(cs, return RemoveUnlockedTx(tx->GetHash()));
+    if (fUpdated) {
+        // one of the TXs we were waiting for got locked, the tip might be signable now
+        ScheduleTrySignChainTip(0);
+    }
+}
+
 void CChainLocksHandler::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex, const std::vector<CTransactionRef>& vtxConflicted)
 {
     if (!masternodeSync.IsBlockchainSynced()) {
@@ -364,8 +445,26 @@ void CChainLocksHandler::BlockConnected(const std::shared_ptr<const CBlock>& pbl
     // We need this information later when we try to sign a new tip, so that we can determine if all included TXs are
     // safe.
 
+    const int64_t nConnectedTime = GetTimeMillis();
+
+    // figure out which TXs are not locked yet before taking cs, IsLocked has to access the islock db
+    std::unordered_set<uint256, StaticSaltedHasher> unlockedTxids;
+    if (IsInstantSendEnabled()) {
+        for (const auto& tx : pblock->vtx) {
+            if (tx->IsCoinBase() || tx->vin.empty()) {
+                continue;
+            }
+            if (!quorumInstantSendManager->IsLocked(tx->GetHash())) {
+                unlockedTxids.emplace(tx->GetHash());
+            }
+        }
+    }
+
     LOCK(cs);
 
+    blockConnectedTime.emplace(pindex->GetBlockHash(), nConnectedTime);
+    blockUnlockedTxs[pindex->GetBlockHash()] = std::move(unlockedTxids);
+
     auto it = blockTxs.find(pindex->GetBlockHash());
     if (it == blockTxs.end()) {
         // we must create this entry even if there are no lockable transactions in the block, so that TrySignChainTip
@@ -391,6 +490,8 @@ void CChainLocksHandler::BlockDisconnected(const std::shared_ptr<const CBlock>&
 {
     LOCK(cs);
     blockTxs.erase(pindexDisconnected->GetBlockHash());
+    blockUnlockedTxs.erase(pindexDisconnected->GetBlockHash());
+    blockConnectedTime.erase(pindexDisconnected->GetBlockHash());
 }
 
 CChainLocksHandler::BlockTxs::mapped_type CChainLocksHandler::GetBlockTxs(const uint256& blockHash)
@@ -442,6 +543,66 @@ CChainLocksHandler::BlockTxs::mapped_type CChainLocksHandler::GetBlockTxs(const
     return ret;
 }
 
+std::optional<std::vector<uint256>> CChainLocksHandler::GetBlockUnlockedTxs(const uint256& blockHash)
+{
+    AssertLockNotHeld(cs);
+    AssertLockNotHeld(cs_main);
+
+    {
+        LOCK(cs);
+        auto it = blockUnlockedTxs.find(blockHash);
+        if (it != blockUnlockedTxs.end()) {
+            return std::vector<uint256>(it->second.begin(), it->second.end());
+        }
+    }
+
+    // Not connected while we were running (or not synced at that time), fall back to the full list of TXs
+    auto txids = GetBlockTxs(blockHash);
+    if (!txids) {
+        return std::nullopt;
+    }
+
+    std::unordered_set<uint256, StaticSaltedHasher> unlockedTxids;
+    for (const auto& txid : *txids) {
+        if (!quorumInstantSendManager->IsLocked(txid)) {
+            unlockedTxids.emplace(txid);
+        }
+    }
+    std::vector<uint256> ret(unlockedTxids.begin(), unlockedTxids.end());
+
+    LOCK(cs);
+    blockUnlockedTxs.emplace(blockHash, std::move(unlockedTxids));
+    return ret;
+}
+
+bool CChainLocksHandler::RemoveUnlockedTx(const uint256& txid)
+{
+    AssertLockHeld(cs);
+
+    // only a handful of recent blocks are tracked here, so no need for a reverse index
+    bool fRemoved{false};
+    for (auto& [_, txids] : blockUnlockedTxs) {
+        fRemoved |= txids.erase(txid) != 0;
+    }
+    return fRemoved;
+}
+
+CChainLocksStats CChainLocksHandler::GetStats() const
+{
+    const uint256 tipHash = WITH_LOCK(cs_main, return ::ChainActive().Tip() ? ::ChainActive().Tip()->GetBlockHash() : uint256());
+
+    LOCK(cs);
+    CChainLocksStats ret = stats;
+    ret.nTrackedBlocks = blockUnlockedTxs.size();
+    for (const auto& [blockHash, txids] : blockUnlockedTxs) {
+        ret.nUnlockedTxs += txids.size();
+        if (blockHash == tipHash) {
+            ret.nTipUnlockedTxs = txids.size();
+        }
+    }
+    return ret;
+}
+
 bool CChainLocksHandler::IsTxSafeForMining(const uint256& txid) const
 {
     if (!RejectConflictingBlocks()) {
@@ -646,8 +807,12 @@ void CChainLocksHandler::Cleanup()
             for (auto& txid : *it->second) {
                 txFirstSeenTime.erase(txid);
             }
+            blockUnlockedTxs.erase(it->first);
+            blockConnectedTime.erase(it->first);
             it = blockTxs.erase(it);
         } else if (InternalHasConflictingChainLock(pindex->nHeight, pindex->GetBlockHash())) {
+            blockUnlockedTxs.erase(it->first);
+            blockConnectedTime.erase(it->first);
             it = blockTxs.erase(it);
         } else {
             ++it;
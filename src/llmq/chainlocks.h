@@ -17,6 +17,7 @@
 #include <sync.h>
 
 #include <atomic>
+#include <optional>
 #include <unordered_set>
 
 class CBlockIndex;
@@ -25,6 +26,29 @@ class CScheduler;
 namespace llmq
 {
 
+struct CChainLocksStats
+{
+    // number of TrySignChainTip runs which got past the cheap early-outs
+    uint64_t nSignAttempts{0};
+    // number of those runs which had to wait for islocks (or for TXs to become old enough)
+    uint64_t nSignAttemptsWaiting{0};
+    // number of times we actually asked the signing manager to sign a tip
+    uint64_t nSignRequests{0};
+    uint64_t nChainLocksProcessed{0};
+
+    // block arrival (BlockConnected) to our own sign request/new CLSIG, -1 if not known yet
+    int64_t nLastBlockToSignMs{-1};
+    int64_t nLastBlockToChainLockMs{-1};
+    int64_t nMaxBlockToChainLockMs{-1};
+    int64_t nTotalBlockToChainLockMs{0};
+    uint64_t nBlockToChainLockSamples{0};
+
+    // snapshot of the incrementally maintained per block state
+    size_t nTrackedBlocks{0};
+    size_t nUnlockedTxs{0};
+    size_t nTipUnlockedTxs{0};
+};
+
 class CChainLocksHandler : public CRecoveredSigsListener
 {
     static constexpr int64_t CLEANUP_INTERVAL = 1000 * 30;
@@ -38,6 +62,8 @@ private:
     std::unique_ptr<std::thread> scheduler_thread;
     mutable CCriticalSection cs;
     std::atomic<bool> tryLockChainTipScheduled{false};
+    // deadline (GetTimeMillis) of the earliest pending delayed retry, 0 if there is none
+    std::atomic<int64_t> tryLockChainTipRetryDeadline{0};
     std::atomic<bool> isEnabled{false};
     std::atomic<bool> isEnforced{false};
 
@@ -60,6 +86,14 @@ private:
     using BlockTxs = std::unordered_map<uint256, std::shared_ptr<std::unordered_set<uint256, StaticSaltedHasher>>, BlockHasher>;
     BlockTxs blockTxs GUARDED_BY(cs);
     std::unordered_map<uint256, int64_t, StaticSaltedHasher> txFirstSeenTime GUARDED_BY(cs);
+    // Subset of blockTxs which was neither islocked nor old enough when we last looked at it. Entries are removed
+    // as soon as the corresponding islock arrives, so that TrySignChainTip does not have to re-check every TX of
+    // the last blocks on each attempt. The size of each set is the "unlocked TX count" of the block.
+    std::unordered_map<uint256, std::unordered_set<uint256, StaticSaltedHasher>, BlockHasher> blockUnlockedTxs GUARDED_BY(cs);
+    // GetTimeMillis() of when we saw the block getting connected, used for latency stats
+    std::unordered_map<uint256, int64_t, BlockHasher> blockConnectedTime GUARDED_BY(cs);
+
+    CChainLocksStats stats GUARDED_BY(cs);
 
     std::map<uint256, int64_t> seenChainLocks GUARDED_BY(cs);
 
@@ -81,6 +115,7 @@ public:
     void AcceptedBlockHeader(const CBlockIndex* pindexNew);
     void UpdatedBlockTip();
     void TransactionAddedToMempool(const CTransactionRef& tx, int64_t nAcceptTime);
+    void NotifyTransactionLock(const CTransactionRef& tx);
     void BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex, const std::vector<CTransactionRef>& vtxConflicted);
     void BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexDisconnected);
     void CheckActiveState();
@@ -93,12 +128,18 @@ public:
 
     bool IsTxSafeForMining(const uint256& txid) const;
 
+    CChainLocksStats GetStats() const;
+
 private:
     // these require locks to be held already
     bool InternalHasChainLock(int nHeight, const uint256& blockHash) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     bool InternalHasConflictingChainLock(int nHeight, const uint256& blockHash) const EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     BlockTxs::mapped_type GetBlockTxs(const uint256& blockHash);
+    std::optional<std::vector<uint256>> GetBlockUnlockedTxs(const uint256& blockHash);
+    bool RemoveUnlockedTx(const uint256& txid) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    void ScheduleTrySignChainTip(int64_t nDelayMs);
 
     void Cleanup();
 };
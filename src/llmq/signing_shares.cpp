@@ -102,36 +102,16 @@ std::string CBatchedSigShares::ToInvString() const
     return inv.ToString();
 }
 
-template<typename T>
-static void InitSession(CSigSharesNodeState::Session& s, const uint256& signHash, T& from)
-{
-    const auto& llmq_params = GetLLMQParams((Consensus::LLMQType)from.llmqType);
-
-    s.llmqType = (Consensus::LLMQType)from.llmqType;
-    s.quorumHash = from.quorumHash;
-    s.id = from.id;
-    s.msgHash = from.msgHash;
-    s.signHash = signHash;
-    s.announced.Init((size_t)llmq_params.size);
-    s.requested.Init((size_t)llmq_params.size);
-    s.knows.Init((size_t)llmq_params.size);
-}
-
-CSigSharesNodeState::Session& CSigSharesNodeState::GetOrCreateSessionFromShare(const llmq::CSigShare& sigShare)
+CSigSharesNodeState::Session& CSigSharesNodeState::GetOrCreateSession(const std::shared_ptr<SessionInfo>& info)
 {
-    auto& s = sessions[sigShare.GetSignHash()];
-    if (s.announced.inv.empty()) {
-        InitSession(s, sigShare.GetSignHash(), sigShare);
-    }
-    return s;
-}
+    auto& s = sessions[info->signHash];
+    if (!s.info) {
+        const auto& llmq_params = GetLLMQParams(info->llmqType);
 
-CSigSharesNodeState::Session& CSigSharesNodeState::GetOrCreateSessionFromAnn(const llmq::CSigSesAnn& ann)
-{
-    auto signHash = CLLMQUtils::BuildSignHash(ann.llmqType, ann.quorumHash, ann.id, ann.msgHash);
-    auto& s = sessions[signHash];
-    if (s.announced.inv.empty()) {
-        InitSession(s, signHash, ann);
+        s.info = info;
+        s.announced.Init((size_t)llmq_params.size);
+        s.requested.Init((size_t)llmq_params.size);
+        s.knows.Init((size_t)llmq_params.size);
     }
     return s;
 }
@@ -160,12 +140,7 @@ bool CSigSharesNodeState::GetSessionInfoByRecvId(uint32_t sessionId, SessionInfo
     if (!s) {
         return false;
     }
-    retInfo.llmqType = s->llmqType;
-    retInfo.quorumHash = s->quorumHash;
-    retInfo.id = s->id;
-    retInfo.msgHash = s->msgHash;
-    retInfo.signHash = s->signHash;
-    retInfo.quorum = s->quorum;
+    retInfo = *s->info;
 
     return true;
 }
@@ -180,6 +155,18 @@ void CSigSharesNodeState::RemoveSession(const uint256& signHash)
     pendingIncomingSigShares.EraseAllForSignHash(signHash);
 }
 
+size_t CSigSharesNodeState::DynamicMemoryUsage() const
+{
+    size_t usage = memusage::DynamicUsage(sessions) + memusage::DynamicUsage(sessionByRecvId);
+    for (const auto& [_, session] : sessions) {
+        // announced, requested and knows are all std::vector<bool> of the quorum size, which are stored as bitsets
+        usage += 3 * memusage::MallocUsage((session.announced.inv.size() + 63) / 64 * 8);
+    }
+    usage += pendingIncomingSigShares.DynamicMemoryUsage();
+    usage += requestedSigShares.DynamicMemoryUsage();
+    return usage;
+}
+
 //////////////////////
 
 void CSigSharesManager::StartWorkerThread()
@@ -322,13 +309,15 @@ bool CSigSharesManager::ProcessMessageSigSesAnn(const CNode* pfrom, const CSigSe
         return true; // let's still try other announcements from the same message
     }
 
+    const auto signHash = CLLMQUtils::BuildSignHash(ann.llmqType, ann.quorumHash, ann.id, ann.msgHash);
+
     LOCK(cs);
     auto& nodeState = nodeStates[pfrom->GetId()];
-    auto& session = nodeState.GetOrCreateSessionFromAnn(ann);
+    auto& session = nodeState.GetOrCreateSession(GetOrCreateSessionInfo(signHash, ann));
     nodeState.sessionByRecvId.erase(session.recvSessionId);
     nodeState.sessionByRecvId.erase(ann.sessionId);
     session.recvSessionId = ann.sessionId;
-    session.quorum = quorum;
+    session.info->quorum = quorum;
     nodeState.sessionByRecvId.try_emplace(ann.sessionId, &session);
 
     return true;
@@ -722,15 +711,16 @@ void CSigSharesManager::ProcessSigShare(const CSigShare& sigShare, const CConnma
         }
 
         // Update the time we've seen the last sigShare
-        timeSeenForSessions[sigShare.GetSignHash()] = GetAdjustedTime();
+        UpdateTimeSeenForSession(sigShare.GetSignHash(), GetAdjustedTime());
 
         if (!quorumNodes.empty()) {
             // don't announce and wait for other nodes to request this share and directly send it to them
             // there is no way the other nodes know about this share as this is the one created on this node
+            auto sessionInfo = GetOrCreateSessionInfo(sigShare.GetSignHash(), sigShare);
+            sessionInfo->quorum = quorum;
             for (auto otherNodeId : quorumNodes) {
                 auto& nodeState = nodeStates[otherNodeId];
-                auto& session = nodeState.GetOrCreateSessionFromShare(sigShare);
-                session.quorum = quorum;
+                auto& session = nodeState.GetOrCreateSession(sessionInfo);
                 session.requested.Set(sigShare.quorumMember, true);
                 session.knows.Set(sigShare.quorumMember, true);
             }
@@ -862,7 +852,7 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
         decltype(sigSharesToRequest.begin()->second)* invMap = nullptr;
 
         for (auto& [signHash, session] : nodeState.sessions) {
-            if (CLLMQUtils::IsAllMembersConnectedEnabled(session.llmqType)) {
+            if (CLLMQUtils::IsAllMembersConnectedEnabled(session.info->llmqType)) {
                 continue;
             }
 
@@ -908,7 +898,7 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
                 }
                 auto& inv = (*invMap)[signHash];
                 if (inv.inv.empty()) {
-                    inv.Init(GetLLMQParams(session.llmqType).size);
+                    inv.Init(GetLLMQParams(session.info->llmqType).size);
                 }
                 inv.inv[k.second] = true;
 
@@ -931,7 +921,7 @@ void CSigSharesManager::CollectSigSharesToSend(std::unordered_map<NodeId, std::u
         decltype(sigSharesToSend.begin()->second)* sigSharesToSend2 = nullptr;
 
         for (auto& [signHash, session] : nodeState.sessions) {
-            if (CLLMQUtils::IsAllMembersConnectedEnabled(session.llmqType)) {
+            if (CLLMQUtils::IsAllMembersConnectedEnabled(session.info->llmqType)) {
                 continue;
             }
 
@@ -1046,7 +1036,7 @@ void CSigSharesManager::CollectSigSharesToAnnounce(std::unordered_map<NodeId, st
                 continue;
             }
 
-            auto& session = nodeState.GetOrCreateSessionFromShare(*sigShare);
+            auto& session = nodeState.GetOrCreateSession(GetOrCreateSessionInfo(signHash, *sigShare));
 
             if (session.knows.inv[quorumMember]) {
                 // he already knows that one
@@ -1084,10 +1074,10 @@ bool CSigSharesManager::SendMessages()
 
             CSigSesAnn sigSesAnn;
             sigSesAnn.sessionId = session->sendSessionId;
-            sigSesAnn.llmqType = session->llmqType;
-            sigSesAnn.quorumHash = session->quorumHash;
-            sigSesAnn.id = session->id;
-            sigSesAnn.msgHash = session->msgHash;
+            sigSesAnn.llmqType = session->info->llmqType;
+            sigSesAnn.quorumHash = session->info->quorumHash;
+            sigSesAnn.id = session->info->id;
+            sigSesAnn.msgHash = session->info->msgHash;
 
             sigSessionAnnouncements[nodeId].emplace_back(sigSesAnn);
         }
@@ -1251,6 +1241,70 @@ CSigShare CSigSharesManager::RebuildSigShare(const CSigSharesNodeState::SessionI
     return sigShare;
 }
 
+template<typename T>
+std::shared_ptr<CSigSharesNodeState::SessionInfo> CSigSharesManager::GetOrCreateSessionInfo(const uint256& signHash, const T& from)
+{
+    AssertLockHeld(cs);
+
+    auto& weakInfo = sessionInfos[signHash];
+    auto info = weakInfo.lock();
+    if (!info) {
+        info = std::make_shared<CSigSharesNodeState::SessionInfo>();
+        info->llmqType = (Consensus::LLMQType)from.llmqType;
+        info->quorumHash = from.quorumHash;
+        info->id = from.id;
+        info->msgHash = from.msgHash;
+        info->signHash = signHash;
+        weakInfo = info;
+    }
+    return info;
+}
+
+void CSigSharesManager::UpdateTimeSeenForSession(const uint256& signHash, int64_t nTime)
+{
+    AssertLockHeld(cs);
+
+    auto [it, inserted] = timeSeenForSessions.try_emplace(signHash, nTime);
+    if (!inserted) {
+        if (it->second == nTime) {
+            return;
+        }
+        sessionsByTimeSeen.erase(std::make_pair(it->second, signHash));
+        it->second = nTime;
+    }
+    sessionsByTimeSeen.emplace(nTime, signHash);
+}
+
+CSigSharesStats CSigSharesManager::GetStats()
+{
+    LOCK(cs);
+
+    CSigSharesStats stats;
+    stats.nSigShares = sigShares.Size();
+    stats.nNodeStates = nodeStates.size();
+    stats.nSigSharesUsage = sigShares.DynamicMemoryUsage() + sigSharesRequested.DynamicMemoryUsage() + sigSharesQueuedToAnnounce.DynamicMemoryUsage();
+
+    stats.nNodeStatesUsage = memusage::DynamicUsage(nodeStates);
+    for (const auto& [_, nodeState] : nodeStates) {
+        stats.nNodeSessions += nodeState.sessions.size();
+        stats.nPendingIncomingSigShares += nodeState.pendingIncomingSigShares.Size();
+        stats.nRequestedSigShares += nodeState.requestedSigShares.Size();
+        stats.nNodeStatesUsage += nodeState.DynamicMemoryUsage();
+    }
+
+    for (const auto& [_, weakInfo] : sessionInfos) {
+        if (!weakInfo.expired()) {
+            stats.nSessions++;
+        }
+    }
+    // make_shared puts the control block and the object into the same allocation
+    stats.nSessionsUsage = memusage::DynamicUsage(sessionInfos) +
+                           stats.nSessions * memusage::MallocUsage(sizeof(CSigSharesNodeState::SessionInfo) + 2 * sizeof(void*)) +
+                           memusage::DynamicUsage(timeSeenForSessions) + memusage::DynamicUsage(sessionsByTimeSeen) +
+                           memusage::DynamicUsage(signedSessions);
+    return stats;
+}
+
 void CSigSharesManager::Cleanup()
 {
     int64_t now = GetAdjustedTime();
@@ -1266,7 +1320,7 @@ void CSigSharesManager::Cleanup()
 
     {
         LOCK(cs);
-        sigShares.ForEach([&quorums](const SigShareKey&, const CSigShare& sigShare) {
+        sigShares.ForEachSignHash([&quorums](const uint256&, const CSigShare& sigShare) {
             quorums.try_emplace(std::make_pair(sigShare.llmqType, sigShare.quorumHash), nullptr);
         });
     }
@@ -1285,9 +1339,9 @@ void CSigSharesManager::Cleanup()
         // Now delete sessions which are for inactive quorums
         LOCK(cs);
         std::unordered_set<uint256, StaticSaltedHasher> inactiveQuorumSessions;
-        sigShares.ForEach([&quorums, &inactiveQuorumSessions](const SigShareKey&, const CSigShare& sigShare) {
+        sigShares.ForEachSignHash([&quorums, &inactiveQuorumSessions](const uint256& signHash, const CSigShare& sigShare) {
             if (!quorums.count(std::make_pair(sigShare.llmqType, sigShare.quorumHash))) {
-                inactiveQuorumSessions.emplace(sigShare.GetSignHash());
+                inactiveQuorumSessions.emplace(signHash);
             }
         });
         for (auto& signHash : inactiveQuorumSessions) {
@@ -1300,24 +1354,22 @@ void CSigSharesManager::Cleanup()
 
         // Remove sessions which were successfully recovered
         std::unordered_set<uint256, StaticSaltedHasher> doneSessions;
-        sigShares.ForEach([&doneSessions](const SigShareKey&, const CSigShare& sigShare) {
-            if (doneSessions.count(sigShare.GetSignHash())) {
-                return;
-            }
-            if (quorumSigningManager->HasRecoveredSigForSession(sigShare.GetSignHash())) {
-                doneSessions.emplace(sigShare.GetSignHash());
+        sigShares.ForEachSignHash([&doneSessions](const uint256& signHash, const CSigShare&) {
+            if (quorumSigningManager->HasRecoveredSigForSession(signHash)) {
+                doneSessions.emplace(signHash);
             }
         });
         for (auto& signHash : doneSessions) {
             RemoveSigSharesForSession(signHash);
         }
 
-        // Remove sessions which timed out
+        // Remove sessions which timed out. Oldest come first, so we can stop at the first one which is still alive
         std::unordered_set<uint256, StaticSaltedHasher> timeoutSessions;
-        for (const auto& [signHash, lastSeenTime] : timeSeenForSessions) {
-            if (now - lastSeenTime >= SESSION_NEW_SHARES_TIMEOUT) {
-                timeoutSessions.emplace(signHash);
+        for (const auto& [lastSeenTime, signHash] : sessionsByTimeSeen) {
+            if (now - lastSeenTime < SESSION_NEW_SHARES_TIMEOUT) {
+                break;
             }
+            timeoutSessions.emplace(signHash);
         }
         for (auto& signHash : timeoutSessions) {
 
@@ -1377,6 +1429,15 @@ void CSigSharesManager::Cleanup()
         nodeStates.erase(nodeId);
     }
 
+    // Drop interned session infos which are not referenced by any node session anymore
+    for (auto it = sessionInfos.begin(); it != sessionInfos.end(); ) {
+        if (it->second.expired()) {
+            it = sessionInfos.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     lastCleanupTime = GetAdjustedTime();
 }
 
@@ -1392,7 +1453,11 @@ void CSigSharesManager::RemoveSigSharesForSession(const uint256& signHash)
     sigSharesQueuedToAnnounce.EraseAllForSignHash(signHash);
     sigShares.EraseAllForSignHash(signHash);
     signedSessions.erase(signHash);
-    timeSeenForSessions.erase(signHash);
+    if (const auto it = timeSeenForSessions.find(signHash); it != timeSeenForSessions.end()) {
+        sessionsByTimeSeen.erase(std::make_pair(it->second, signHash));
+        timeSeenForSessions.erase(it);
+    }
+    sessionInfos.erase(signHash);
 }
 
 void CSigSharesManager::RemoveBannedNodeStates()
@@ -7,6 +7,7 @@
 
 #include <bls/bls.h>
 #include <llmq/signing.h>
+#include <memusage.h>
 #include <net.h>
 #include <random.h>
 #include <saltedhasher.h>
@@ -14,8 +15,10 @@
 #include <sync.h>
 #include <uint256.h>
 
+#include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 class CEvoDB;
@@ -267,12 +270,33 @@ public:
             }
         }
     }
+
+    // Calls f only once per signHash, passing one (arbitrary) entry of it. Useful when only the session matters, as
+    // it doesn't have to touch every single entry
+    template<typename F>
+    void ForEachSignHash(F&& f) const
+    {
+        for (const auto& [signHash, m] : internalMap) {
+            f(signHash, m.begin()->second);
+        }
+    }
+
+    // Only accounts for the maps themselves, not for dynamic memory owned by T
+    [[nodiscard]] size_t DynamicMemoryUsage() const
+    {
+        size_t usage = memusage::DynamicUsage(internalMap);
+        for (const auto& p : internalMap) {
+            usage += memusage::DynamicUsage(p.second);
+        }
+        return usage;
+    }
 };
 
 class CSigSharesNodeState
 {
 public:
-    // Used to avoid holding locks too long
+    // Used to avoid holding locks too long. Also shared by all node states which know the same session, so that the
+    // per node session only has to keep track of the per node state
     struct SessionInfo
     {
         Consensus::LLMQType llmqType;
@@ -288,13 +312,8 @@ public:
         uint32_t recvSessionId{UNINITIALIZED_SESSION_ID};
         uint32_t sendSessionId{UNINITIALIZED_SESSION_ID};
 
-        Consensus::LLMQType llmqType;
-        uint256 quorumHash;
-        uint256 id;
-        uint256 msgHash;
-        uint256 signHash;
-
-        CQuorumCPtr quorum;
+        // interned by CSigSharesManager, see CSigSharesManager::sessionInfos
+        std::shared_ptr<SessionInfo> info;
 
         CSigSharesInv announced;
         CSigSharesInv requested;
@@ -311,13 +330,29 @@ public:
 
     bool banned{false};
 
-    Session& GetOrCreateSessionFromShare(const CSigShare& sigShare);
-    Session& GetOrCreateSessionFromAnn(const CSigSesAnn& ann);
+    Session& GetOrCreateSession(const std::shared_ptr<SessionInfo>& info);
     Session* GetSessionBySignHash(const uint256& signHash);
     Session* GetSessionByRecvId(uint32_t sessionId);
     bool GetSessionInfoByRecvId(uint32_t sessionId, SessionInfo& retInfo);
 
     void RemoveSession(const uint256& signHash);
+
+    [[nodiscard]] size_t DynamicMemoryUsage() const;
+};
+
+struct CSigSharesStats
+{
+    size_t nSessions{0};
+    size_t nSigShares{0};
+    size_t nNodeStates{0};
+    size_t nNodeSessions{0};
+    size_t nPendingIncomingSigShares{0};
+    size_t nRequestedSigShares{0};
+
+    // estimated dynamic memory usage in bytes
+    size_t nSigSharesUsage{0};
+    size_t nNodeStatesUsage{0};
+    size_t nSessionsUsage{0};
 };
 
 class CSignedSession
@@ -357,6 +392,12 @@ private:
 
     // stores time of last receivedSigShare. Used to detect timeouts
     std::unordered_map<uint256, int64_t, StaticSaltedHasher> timeSeenForSessions GUARDED_BY(cs);
+    // same as timeSeenForSessions but ordered by time, so that Cleanup() only has to look at sessions which timed out
+    std::set<std::pair<int64_t, uint256>> sessionsByTimeSeen GUARDED_BY(cs);
+
+    // Immutable session data, interned so that it's only stored once no matter how many nodes are part of a session.
+    // Entries expire together with the last node session referencing them
+    std::unordered_map<uint256, std::weak_ptr<CSigSharesNodeState::SessionInfo>, StaticSaltedHasher> sessionInfos GUARDED_BY(cs);
 
     std::unordered_map<NodeId, CSigSharesNodeState> nodeStates GUARDED_BY(cs);
     SigShareMap<std::pair<NodeId, int64_t>> sigSharesRequested GUARDED_BY(cs);
@@ -400,6 +441,8 @@ public:
 
     static CDeterministicMNCPtr SelectMemberForRecovery(const CQuorumCPtr& quorum, const uint256& id, size_t attempt);
 
+    CSigSharesStats GetStats();
+
 private:
     // all of these return false when the currently processed message should be aborted (as each message actually contains multiple messages)
     bool ProcessMessageSigSesAnn(const CNode* pfrom, const CSigSesAnn& ann);
@@ -426,6 +469,10 @@ private:
     bool GetSessionInfoByRecvId(NodeId nodeId, uint32_t sessionId, CSigSharesNodeState::SessionInfo& retInfo);
     static CSigShare RebuildSigShare(const CSigSharesNodeState::SessionInfo& session, const std::pair<uint16_t, CBLSLazySignature>& in);
 
+    template<typename T>
+    std::shared_ptr<CSigSharesNodeState::SessionInfo> GetOrCreateSessionInfo(const uint256& signHash, const T& from) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void UpdateTimeSeenForSession(const uint256& signHash, int64_t nTime) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
     void Cleanup();
     void RemoveSigSharesForSession(const uint256& signHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void RemoveBannedNodeStates();
@@ -280,12 +280,10 @@ bool BuildQuorumRotationInfo(const CGetQuorumRotationInfo& request, CQuorumRotat
             response.quorumSnapshotAtHMinus4C = std::move(snapshotHMinus4C);
         }
 
-        CSimplifiedMNListDiff mn4c;
-        if (!BuildSimplifiedMNListDiff(GetLastBaseBlockHash(baseBlockIndexes, pWorkBlockHMinus4CIndex), pWorkBlockHMinus4CIndex->GetBlockHash(), mn4c, errorRet)) {
+        // Build diffs in place, these can be large and copying them around would double the cost of the response
+        if (!BuildSimplifiedMNListDiff(GetLastBaseBlockHash(baseBlockIndexes, pWorkBlockHMinus4CIndex), pWorkBlockHMinus4CIndex->GetBlockHash(), response.mnListDiffAtHMinus4C.emplace(), errorRet)) {
             return false;
         }
-
-        response.mnListDiffAtHMinus4C = std::move(mn4c);
     } else {
         response.extraShare = false;
         response.quorumSnapshotAtHMinus4C = std::nullopt;
@@ -295,6 +293,7 @@ bool BuildQuorumRotationInfo(const CGetQuorumRotationInfo& request, CQuorumRotat
     std::set<int> snapshotHeightsNeeded;
 
     std::vector<std::pair<int, const CBlockIndex*>> qdata = quorumBlockProcessor->GetLastMinedCommitmentsPerQuorumIndexUntilBlock(llmqType, blockIndex, 0);
+    response.lastCommitmentPerIndex.reserve(qdata.size());
 
     for (const auto& obj : qdata) {
         uint256 minedBlockHash;
@@ -333,15 +332,12 @@ bool BuildQuorumRotationInfo(const CGetQuorumRotationInfo& request, CQuorumRotat
             errorRet = strprintf("Can not find quorum snapshot at H(%d)", h);
             return false;
         } else {
-            response.quorumSnapshotList.push_back(snapshotNeededH.value());
+            response.quorumSnapshotList.push_back(std::move(snapshotNeededH.value()));
         }
 
-        CSimplifiedMNListDiff mnhneeded;
-        if (!BuildSimplifiedMNListDiff(GetLastBaseBlockHash(baseBlockIndexes, pNeededWorkBlockIndex), pNeededWorkBlockIndex->GetBlockHash(), mnhneeded, errorRet)) {
+        if (!BuildSimplifiedMNListDiff(GetLastBaseBlockHash(baseBlockIndexes, pNeededWorkBlockIndex), pNeededWorkBlockIndex->GetBlockHash(), response.mnListDiffList.emplace_back(), errorRet)) {
             return false;
         }
-
-        response.mnListDiffList.push_back(mnhneeded);
     }
 
     return true;
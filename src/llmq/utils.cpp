@@ -608,12 +608,92 @@ uint256 CLLMQUtils::DeterministicOutboundConnection(const uint256& proTxHash1, c
     return proTxHash2;
 }
 
+namespace {
+// Connection and relay sets only depend on the members of a quorum, so they are built once per quorum base block and
+// then reused on every tip update instead of being recalculated from scratch for each active quorum
+struct QuorumConnectionTables
+{
+    // Relay targets of every member. These are built for all members at once, as the inbound relay members of a
+    // single member can only be determined by looking at the outbound sets of all others
+    bool fRelayBuilt{false};
+    std::map<uint256, std::set<uint256>> relayOutbound;
+    std::map<uint256, std::set<uint256>> relayInbound;
+    // (forMember, onlyOutbound) -> connections, filled lazily as this requires hashing every pair of members
+    std::map<std::pair<uint256, bool>, std::set<uint256>> connections;
+};
+using QuorumConnectionTablesPtr = std::shared_ptr<QuorumConnectionTables>;
+
+CCriticalSection cs_connection_tables;
+std::map<Consensus::LLMQType, unordered_lru_cache<uint256, QuorumConnectionTablesPtr, StaticSaltedHasher>> mapQuorumConnectionTables GUARDED_BY(cs_connection_tables);
+
+QuorumConnectionTablesPtr GetQuorumConnectionTables(Consensus::LLMQType llmqType, const uint256& quorumHash) EXCLUSIVE_LOCKS_REQUIRED(cs_connection_tables)
+{
+    if (mapQuorumConnectionTables.empty()) {
+        CLLMQUtils::InitQuorumsCache(mapQuorumConnectionTables);
+    }
+    auto it = mapQuorumConnectionTables.find(llmqType);
+    if (it == mapQuorumConnectionTables.end()) {
+        return std::make_shared<QuorumConnectionTables>();
+    }
+    QuorumConnectionTablesPtr tables;
+    if (!it->second.get(quorumHash, tables)) {
+        tables = std::make_shared<QuorumConnectionTables>();
+        it->second.insert(quorumHash, tables);
+    }
+    return tables;
+}
+
+std::set<uint256> CalcRelayOutbound(const std::vector<CDeterministicMNCPtr>& mns, size_t i)
+{
+    if (mns.size() == 1) {
+        // No outbound connections are needed when there is one MN only.
+        // Also note that trying to calculate results via the algorithm below
+        // would result in an endless loop.
+        return std::set<uint256>();
+    }
+    // Relay to nodes at indexes (i+2^k)%n, where
+    //   k: 0..max(1, floor(log2(n-1))-1)
+    //   n: size of the quorum/ring
+    std::set<uint256> r;
+    int gap = 1;
+    int gap_max = (int)mns.size() - 1;
+    int k = 0;
+    while ((gap_max >>= 1) || k <= 1) {
+        size_t idx = (i + gap) % mns.size();
+        // It doesn't matter if this node is going to be added to the resulting set or not,
+        // we should always bump the gap and the k (step count) regardless.
+        // Refusing to bump the gap results in an incomplete set in the best case scenario
+        // (idx won't ever change again once we hit `==`). Not bumping k guarantees an endless
+        // loop when the first or the second node we check is the one that should be skipped
+        // (k <= 1 forever).
+        gap <<= 1;
+        k++;
+        const auto& otherDmn = mns[idx];
+        if (otherDmn->proTxHash == mns[i]->proTxHash) {
+            continue;
+        }
+        r.emplace(otherDmn->proTxHash);
+    }
+    return r;
+}
+} // anonymous namespace
+
 std::set<uint256> CLLMQUtils::GetQuorumConnections(const Consensus::LLMQParams& llmqParams, const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
 {
     if (IsAllMembersConnectedEnabled(llmqParams.type)) {
         auto mns = GetAllQuorumMembers(llmqParams.type, pQuorumBaseBlockIndex);
-        std::set<uint256> result;
+        if (mns.empty()) {
+            return {};
+        }
+
+        LOCK(cs_connection_tables);
+        auto tables = GetQuorumConnectionTables(llmqParams.type, pQuorumBaseBlockIndex->GetBlockHash());
+        auto it = tables->connections.find(std::make_pair(forMember, onlyOutbound));
+        if (it != tables->connections.end()) {
+            return it->second;
+        }
 
+        std::set<uint256> result;
         for (const auto& dmn : mns) {
             if (dmn->proTxHash == forMember) {
                 continue;
@@ -626,6 +706,7 @@ std::set<uint256> CLLMQUtils::GetQuorumConnections(const Consensus::LLMQParams&
                 result.emplace(dmn->proTxHash);
             }
         }
+        tables->connections.emplace(std::make_pair(forMember, onlyOutbound), result);
         return result;
     } else {
         return GetQuorumRelayMembers(llmqParams, pQuorumBaseBlockIndex, forMember, onlyOutbound);
@@ -635,54 +716,33 @@ std::set<uint256> CLLMQUtils::GetQuorumConnections(const Consensus::LLMQParams&
 std::set<uint256> CLLMQUtils::GetQuorumRelayMembers(const Consensus::LLMQParams& llmqParams, const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
 {
     auto mns = GetAllQuorumMembers(llmqParams.type, pQuorumBaseBlockIndex);
-    std::set<uint256> result;
+    if (mns.empty()) {
+        return {};
+    }
 
-    auto calcOutbound = [&](size_t i, const uint256& proTxHash) {
-        if (mns.size() == 1) {
-            // No outbound connections are needed when there is one MN only.
-            // Also note that trying to calculate results via the algorithm below
-            // would result in an endless loop.
-            return std::set<uint256>();
-        }
-        // Relay to nodes at indexes (i+2^k)%n, where
-        //   k: 0..max(1, floor(log2(n-1))-1)
-        //   n: size of the quorum/ring
-        std::set<uint256> r;
-        int gap = 1;
-        int gap_max = (int)mns.size() - 1;
-        int k = 0;
-        while ((gap_max >>= 1) || k <= 1) {
-            size_t idx = (i + gap) % mns.size();
-            // It doesn't matter if this node is going to be added to the resulting set or not,
-            // we should always bump the gap and the k (step count) regardless.
-            // Refusing to bump the gap results in an incomplete set in the best case scenario
-            // (idx won't ever change again once we hit `==`). Not bumping k guarantees an endless
-            // loop when the first or the second node we check is the one that should be skipped
-            // (k <= 1 forever).
-            gap <<= 1;
-            k++;
-            const auto& otherDmn = mns[idx];
-            if (otherDmn->proTxHash == proTxHash) {
-                continue;
+    LOCK(cs_connection_tables);
+    auto tables = GetQuorumConnectionTables(llmqParams.type, pQuorumBaseBlockIndex->GetBlockHash());
+    if (!tables->fRelayBuilt) {
+        for (size_t i = 0; i < mns.size(); i++) {
+            const auto& proTxHash = mns[i]->proTxHash;
+            auto r = CalcRelayOutbound(mns, i);
+            for (const auto& outbound : r) {
+                tables->relayInbound[outbound].emplace(proTxHash);
             }
-            r.emplace(otherDmn->proTxHash);
+            tables->relayOutbound.emplace(proTxHash, std::move(r));
         }
-        return r;
-    };
+        tables->fRelayBuilt = true;
+    }
 
-    for (size_t i = 0; i < mns.size(); i++) {
-        const auto& dmn = mns[i];
-        if (dmn->proTxHash == forMember) {
-            auto r = calcOutbound(i, dmn->proTxHash);
-            result.insert(r.begin(), r.end());
-        } else if (!onlyOutbound) {
-            auto r = calcOutbound(i, dmn->proTxHash);
-            if (r.count(forMember)) {
-                result.emplace(dmn->proTxHash);
-            }
+    std::set<uint256> result;
+    if (auto it = tables->relayOutbound.find(forMember); it != tables->relayOutbound.end()) {
+        result = it->second;
+    }
+    if (!onlyOutbound) {
+        if (auto it = tables->relayInbound.find(forMember); it != tables->relayInbound.end()) {
+            result.insert(it->second.begin(), it->second.end());
         }
     }
-
     return result;
 }
 
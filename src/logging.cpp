@@ -8,6 +8,8 @@
 #include <util/threadnames.h>
 #include <util/time.h>
 
+#include <chrono>
+
 const char * const DEFAULT_DEBUGLOGFILE = "debug.log";
 
 BCLog::Logger& LogInstance()
@@ -33,6 +35,13 @@ BCLog::Logger& LogInstance()
 
 bool fLogIPs = DEFAULT_LOGIPS;
 
+/**
+ * Suppresses printing of the timestamp when multiple calls are made that don't end in a newline. Kept per thread, so
+ * asynchronous producers can format their messages concurrently without holding m_cs, and a partial line from one
+ * thread doesn't swallow the prefix of another thread's message.
+ */
+static thread_local bool g_started_new_line{true};
+
 static int FileWriteStr(const std::string &str, FILE *fp)
 {
     return fwrite(str.data(), 1, str.size(), fp);
@@ -252,7 +261,7 @@ std::string BCLog::Logger::LogTimestampStr(const std::string& str)
     if (!m_log_timestamps)
         return str;
 
-    if (m_started_new_line) {
+    if (g_started_new_line) {
         int64_t nTimeMicros = GetTimeMicros();
         strStamped = FormatISO8601DateTime(nTimeMicros/1000000);
         if (m_log_time_micros) {
@@ -292,33 +301,36 @@ namespace BCLog {
     }
 }
 
-void BCLog::Logger::LogPrintStr(const std::string& str)
+std::string BCLog::Logger::FormatLogStr(const std::string& str)
 {
-    StdLockGuard scoped_lock(m_cs);
     std::string str_prefixed = LogEscapeMessage(str);
 
-    if (m_log_threadnames && m_started_new_line) {
+    if (m_log_threadnames && g_started_new_line) {
         // 16 chars total, "springbok-" is 5 of them and another 1 is a NUL terminator
         str_prefixed.insert(0, "[" + strprintf("%10s", util::ThreadGetInternalName()) + "] ");
     }
 
     str_prefixed = LogTimestampStr(str_prefixed);
 
-    m_started_new_line = !str.empty() && str[str.size()-1] == '\n';
+    g_started_new_line = !str.empty() && str[str.size()-1] == '\n';
 
-    if (m_buffering) {
-        // buffer if we haven't started logging yet
-        m_msgs_before_open.push_back(str_prefixed);
-        return;
-    }
+    return str_prefixed;
+}
 
+void BCLog::Logger::WriteLogStr(const std::string& str, const std::vector<std::string>& msgs)
+{
     if (m_print_to_console) {
         // print to console
-        fwrite(str_prefixed.data(), 1, str_prefixed.size(), stdout);
+        fwrite(str.data(), 1, str.size(), stdout);
         fflush(stdout);
     }
     for (const auto& cb : m_print_callbacks) {
-        cb(str_prefixed);
+        if (msgs.empty()) {
+            cb(str);
+        }
+        for (const auto& msg : msgs) {
+            cb(msg);
+        }
     }
     if (m_print_to_file) {
         assert(m_fileout != nullptr);
@@ -333,8 +345,184 @@ void BCLog::Logger::LogPrintStr(const std::string& str)
                 m_fileout = new_fileout;
             }
         }
-        FileWriteStr(str_prefixed, m_fileout);
+        FileWriteStr(str, m_fileout);
+    }
+}
+
+void BCLog::Logger::LogPrintStr(const std::string& str)
+{
+    // Registering as a producer before checking m_async makes sure StopAsyncWriter doesn't drain the buffer while a
+    // message is still being pushed
+    m_async_producers++;
+    if (m_async) {
+        std::string str_prefixed = FormatLogStr(str);
+        PushAsync(str_prefixed);
+        if (--m_async_producers == 0 && !m_async) {
+            // StopAsyncWriter is waiting for us
+            std::lock_guard<std::mutex> lock(m_async_cs);
+            m_async_cond.notify_all();
+        }
+        return;
     }
+    m_async_producers--;
+
+    StdLockGuard scoped_lock(m_cs);
+    std::string str_prefixed = FormatLogStr(str);
+
+    if (m_buffering) {
+        // buffer if we haven't started logging yet
+        m_msgs_before_open.push_back(str_prefixed);
+        return;
+    }
+
+    WriteLogStr(str_prefixed);
+}
+
+/** Set on the writer thread of asynchronous logging */
+static thread_local bool g_is_async_log_writer{false};
+
+void BCLog::Logger::PushAsync(std::string& str_prefixed)
+{
+    if (m_async_buffer->TryPush(str_prefixed)) {
+        return;
+    }
+    // The writer thread itself (e.g. its thread start message) must never wait for itself
+    if (m_async_drop || g_is_async_log_writer) {
+        m_async_dropped++;
+        return;
+    }
+    // Registering as a waiter before retrying makes sure the writer notifies us after freeing space
+    std::unique_lock<std::mutex> lock(m_async_cs);
+    m_async_waiters++;
+    while (!m_async_buffer->TryPush(str_prefixed)) {
+        m_async_cond.wait(lock);
+    }
+    m_async_waiters--;
+}
+
+BCLog::LogRingBuffer::LogRingBuffer(size_t capacity) :
+    m_mask([capacity] {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size - 1;
+    }()),
+    m_cells(new Cell[m_mask + 1])
+{
+    for (size_t i = 0; i <= m_mask; i++) {
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool BCLog::LogRingBuffer::TryPush(std::string& msg)
+{
+    Cell* cell;
+    size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &m_cells[pos & m_mask];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            // the cell is free for this position, claim it
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the cell still holds the message from one round ago
+            return false;
+        } else {
+            // another producer claimed the position
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->msg = std::move(msg);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool BCLog::LogRingBuffer::TryPop(std::string& msg)
+{
+    Cell& cell = m_cells[m_dequeue_pos & m_mask];
+    size_t seq = cell.seq.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(m_dequeue_pos + 1) < 0) {
+        return false;
+    }
+    msg = std::move(cell.msg);
+    cell.msg.clear();
+    // free the cell for the producers of the next round
+    cell.seq.store(m_dequeue_pos + m_mask + 1, std::memory_order_release);
+    m_dequeue_pos++;
+    return true;
+}
+
+void BCLog::Logger::StartAsyncWriter(size_t buffer_size, bool drop_when_full)
+{
+    if (m_async) return;
+
+    m_async_buffer = std::make_unique<LogRingBuffer>(buffer_size);
+    m_async_drop = drop_when_full;
+    m_async_stop = false;
+    m_async_writer = std::thread([this] {
+        g_is_async_log_writer = true;
+        TraceThread("logger", [this] { AsyncWriterThread(); });
+    });
+    m_async = true;
+}
+
+void BCLog::Logger::StopAsyncWriter()
+{
+    if (!m_async) return;
+
+    m_async = false;
+    {
+        // Producers which saw m_async before it was reset may still be pushing (or waiting for space)
+        std::unique_lock<std::mutex> lock(m_async_cs);
+        m_async_cond.wait(lock, [this] { return m_async_producers == 0; });
+    }
+    m_async_stop = true;
+    m_async_writer.join();
+    m_async_buffer.reset();
+}
+
+void BCLog::Logger::AsyncWriterThread()
+{
+    while (!m_async_stop) {
+        if (!WriteAsyncBuffer()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    // write what was queued before StopAsyncWriter() switched back to synchronous mode
+    WriteAsyncBuffer();
+}
+
+bool BCLog::Logger::WriteAsyncBuffer()
+{
+    // Only this thread touches it, so reporting drops doesn't need any synchronization
+    static uint64_t nReportedDropped = 0;
+
+    std::vector<std::string> msgs;
+    std::string str;
+    std::string msg;
+    while (msgs.size() < 1024 && m_async_buffer->TryPop(msg)) {
+        str += msg;
+        msgs.emplace_back(std::move(msg));
+    }
+    if (!msgs.empty() && m_async_waiters > 0) {
+        std::lock_guard<std::mutex> lock(m_async_cs);
+        m_async_cond.notify_all();
+    }
+    uint64_t nDropped = m_async_dropped;
+    if (nDropped != nReportedDropped) {
+        msgs.emplace_back(LogTimestampStr(strprintf("Logging buffer full, dropped %d messages\n", nDropped - nReportedDropped)));
+        str += msgs.back();
+        nReportedDropped = nDropped;
+    }
+    if (msgs.empty()) {
+        return false;
+    }
+
+    StdLockGuard scoped_lock(m_cs);
+    WriteLogStr(str, msgs);
+    return true;
 }
 
 void BCLog::Logger::ShrinkDebugFile()
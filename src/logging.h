@@ -11,16 +11,22 @@
 #include <threadsafety.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 static const bool DEFAULT_LOGTIMEMICROS  = false;
 static const bool DEFAULT_LOGIPS         = false;
 static const bool DEFAULT_LOGTIMESTAMPS  = true;
 static const bool DEFAULT_LOGTHREADNAMES = false;
+static const bool DEFAULT_LOGASYNC       = false;
+static const bool DEFAULT_LOGASYNCDROP   = false;
+static const unsigned int DEFAULT_LOGASYNCBUFFER = 16384;
 extern const char * const DEFAULT_DEBUGLOGFILE;
 
 extern bool fLogThreadNames;
@@ -79,6 +85,34 @@ namespace BCLog {
         ALL         = ~(uint64_t)0,
     };
 
+    /**
+     * Bounded lock-free queue of log messages with any number of producers and a single consumer
+     * (Dmitry Vyukov's bounded MPMC queue with the consumer side simplified). Each cell carries a sequence number
+     * telling producers and the consumer whether it is free or filled for their current position.
+     */
+    class LogRingBuffer
+    {
+    private:
+        struct Cell {
+            std::atomic<size_t> seq;
+            std::string msg;
+        };
+
+        const size_t m_mask;
+        const std::unique_ptr<Cell[]> m_cells;
+        std::atomic<size_t> m_enqueue_pos{0};
+        size_t m_dequeue_pos{0}; //!< Only accessed by the consumer
+
+    public:
+        /** The capacity is rounded up to the next power of two */
+        explicit LogRingBuffer(size_t capacity);
+
+        /** Move msg into the buffer, returns false (leaving msg untouched) if it is full */
+        bool TryPush(std::string& msg);
+        /** Move the oldest message into msg, returns false if the buffer is empty. Must only be called by the consumer. */
+        bool TryPop(std::string& msg);
+    };
+
     class Logger
     {
     private:
@@ -88,19 +122,40 @@ namespace BCLog {
         std::list<std::string> m_msgs_before_open GUARDED_BY(m_cs);
         bool m_buffering GUARDED_BY(m_cs) = true; //!< Buffer messages before logging can be started.
 
-        /**
-         * m_started_new_line is a state variable that will suppress printing of
-         * the timestamp when multiple calls are made that don't end in a
-         * newline.
-         */
-        std::atomic_bool m_started_new_line{true};
-
         /** Log categories bitfield. */
         std::atomic<uint64_t> m_categories{0};
 
         std::string LogTimestampStr(const std::string& str);
         std::string LogThreadNameStr(const std::string &str);
 
+        /** Escape and prefix a message with the thread name and timestamp as configured */
+        std::string FormatLogStr(const std::string& str);
+        /** Write prefixed messages to all outputs, str is the concatenation of msgs (or a single message if msgs is empty) */
+        void WriteLogStr(const std::string& str, const std::vector<std::string>& msgs = {}) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+
+        /**
+         * Asynchronous mode: messages are formatted on the calling thread and queued in m_async_buffer, a dedicated
+         * writer thread writes them in batches. Callers never wait for m_cs or for the disk, unless the buffer is full
+         * and messages are not dropped.
+         */
+        std::atomic<bool> m_async{false};
+        std::atomic<int> m_async_producers{0};
+        std::atomic<bool> m_async_stop{false};
+        std::atomic<uint64_t> m_async_dropped{0};
+        bool m_async_drop{false};
+        std::unique_ptr<LogRingBuffer> m_async_buffer;
+        std::thread m_async_writer;
+        /** Callers waiting for space in the buffer, and StopAsyncWriter waiting for the last producer, block on m_async_cond */
+        StdMutex m_async_cs;
+        std::condition_variable m_async_cond;
+        std::atomic<int> m_async_waiters{0};
+
+        void AsyncWriterThread();
+        /** Queue a prefixed message, waiting for space in the buffer unless messages are dropped */
+        void PushAsync(std::string& str_prefixed);
+        /** Write all queued messages, returns false if there was nothing to write */
+        bool WriteAsyncBuffer();
+
         /** Slots that connect to the print signal */
         std::list<std::function<void(const std::string&)>> m_print_callbacks /* GUARDED_BY(m_cs) */ {};
 
@@ -145,6 +200,17 @@ namespace BCLog {
         /** Only for testing */
         void DisconnectTestLogger();
 
+        /**
+         * Switch to asynchronous mode with a buffer for (at least) buffer_size messages. When the buffer is full,
+         * messages are dropped (and counted) if drop_when_full is set, otherwise callers wait for the writer thread.
+         */
+        void StartAsyncWriter(size_t buffer_size, bool drop_when_full);
+        /** Write all queued messages and switch back to writing on the calling thread */
+        void StopAsyncWriter();
+        bool IsAsync() const { return m_async; }
+        /** Number of messages dropped in asynchronous mode because the buffer was full */
+        uint64_t GetAsyncDropped() const { return m_async_dropped; }
+
         void ShrinkDebugFile();
 
         uint64_t GetCategoryMask() const { return m_categories.load(); }
@@ -102,8 +102,8 @@ void BlockAssembler::resetBlock()
     nFees = 0;
 }
 
-Optional<int64_t> BlockAssembler::m_last_block_num_txs{nullopt};
-Optional<int64_t> BlockAssembler::m_last_block_size{nullopt};
+std::atomic<int64_t> BlockAssembler::m_last_block_num_txs{-1};
+std::atomic<int64_t> BlockAssembler::m_last_block_size{-1};
 
 std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& scriptPubKeyIn)
 {
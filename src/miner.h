@@ -11,6 +11,7 @@
 #include <txmempool.h>
 #include <validation.h>
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
@@ -161,8 +162,10 @@ public:
     /** Construct a new block template with coinbase to scriptPubKeyIn */
     std::unique_ptr<CBlockTemplate> CreateNewBlock(const CScript& scriptPubKeyIn);
 
-    static Optional<int64_t> m_last_block_num_txs;
-    static Optional<int64_t> m_last_block_size;
+    // Number of transactions and size of the last assembled block, -1 until a block was assembled.
+    // Atomic so that getmininginfo can report them without taking cs_main.
+    static std::atomic<int64_t> m_last_block_num_txs;
+    static std::atomic<int64_t> m_last_block_size;
 
 private:
     // utility functions
@@ -35,6 +35,7 @@
 #include <string.h>
 #else
 #include <fcntl.h>
+#include <sys/uio.h>
 #endif
 
 #ifdef USE_POLL
@@ -49,6 +50,7 @@
 #include <sys/event.h>
 #endif
 
+#include <array>
 #include <unordered_map>
 
 #include <math.h>
@@ -59,6 +61,14 @@ static constexpr int DUMP_PEERS_INTERVAL = 15 * 60;
 /** Number of DNS seeds to query when the number of connections is low. */
 static constexpr int DNSSEEDS_TO_QUERY_AT_ONCE = 3;
 
+#ifndef WIN32
+/** Maximum number of queued buffers passed to a single sendmsg() call */
+static constexpr size_t MAX_SEND_IOV = 64;
+#endif
+
+/** Maximum number of priority lane messages processed per node before moving on to the next one */
+static constexpr int MAX_PRIORITY_MESSAGES_PER_ROUND = 100;
+
 // We add a random period time (0 to 1 seconds) to feeler connections to prevent synchronization.
 #define FEELER_SLEEP_WINDOW 1
 
@@ -92,6 +102,27 @@ static const uint64_t SELECT_TIMEOUT_MILLISECONDS = 500;
 
 const std::string NET_MESSAGE_COMMAND_OTHER = "*other*";
 
+CNetMsgTypeStats::CNetMsgTypeStats(const std::string& msg_type) :
+    bytesReceived(statsClient, "bandwidth.message." + msg_type + ".bytesReceived"),
+    bytesSent(statsClient, "bandwidth.message." + msg_type + ".bytesSent"),
+    received(statsClient, "message.received." + msg_type),
+    sent(statsClient, "message.sent." + msg_type)
+{
+}
+
+CNetMsgTypeStats* GetNetMsgTypeStats(const std::string& msg_type)
+{
+    static const std::map<std::string, std::unique_ptr<CNetMsgTypeStats>> mapMsgTypeStats = [] {
+        std::map<std::string, std::unique_ptr<CNetMsgTypeStats>> map;
+        for (const std::string& msg : getAllNetMessageTypes()) {
+            map.emplace(msg, std::make_unique<CNetMsgTypeStats>(msg));
+        }
+        return map;
+    }();
+    auto it = mapMsgTypeStats.find(msg_type);
+    return it != mapMsgTypeStats.end() ? it->second.get() : nullptr;
+}
+
 constexpr const CConnman::CFullyConnectedOnly CConnman::FullyConnectedOnly;
 constexpr const CConnman::CAllNodes CConnman::AllNodes;
 
@@ -647,7 +678,11 @@ bool CNode::ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete
                 i = mapRecvBytesPerMsgCmd.find(NET_MESSAGE_COMMAND_OTHER);
             assert(i != mapRecvBytesPerMsgCmd.end());
             i->second += msg.m_raw_message_size;
-            statsClient.count("bandwidth.message." + std::string(msg.m_command) + ".bytesReceived", msg.m_raw_message_size, 1.0f);
+            if (auto msgTypeStats = GetNetMsgTypeStats(msg.m_command)) {
+                msgTypeStats->bytesReceived.Add(msg.m_raw_message_size);
+            } else {
+                statsClient.count("bandwidth.message." + std::string(msg.m_command) + ".bytesReceived", msg.m_raw_message_size, 1.0f);
+            }
 
             // push the message to the process queue,
             vRecvMsg.push_back(std::move(msg));
@@ -772,12 +807,18 @@ CNetMessage V1TransportDeserializer::GetMessage(const CMessageHeader::MessageSta
     return msg;
 }
 
+CSharedNetMsgPayload::CSharedNetMsgPayload(std::vector<unsigned char>&& _data) :
+    data(std::move(_data)),
+    hash(Hash(data.begin(), data.end()))
+{
+}
+
 void V1TransportSerializer::prepareForTransport(CSerializedNetMsg& msg, std::vector<unsigned char>& header) {
     // create dbl-sha256 checksum
-    uint256 hash = Hash(msg.data.begin(), msg.data.end());
+    uint256 hash = msg.shared_payload ? msg.shared_payload->hash : Hash(msg.data.begin(), msg.data.end());
 
     // create header
-    CMessageHeader hdr(Params().MessageStart(), msg.command.c_str(), msg.data.size());
+    CMessageHeader hdr(Params().MessageStart(), msg.command.c_str(), msg.PayloadSize());
     memcpy(hdr.pchChecksum, hash.begin(), CMessageHeader::CHECKSUM_SIZE);
 
     // serialize header
@@ -791,27 +832,52 @@ size_t CConnman::SocketSendData(CNode *pnode) EXCLUSIVE_LOCKS_REQUIRED(pnode->cs
     size_t nSentSize = 0;
 
     while (it != pnode->vSendMsg.end()) {
-        const auto &data = *it;
-        assert(data.size() > pnode->nSendOffset);
+        assert(it->size() > pnode->nSendOffset);
+        size_t nRequested = 0;
         int nBytes = 0;
         {
             LOCK(pnode->cs_hSocket);
             if (pnode->hSocket == INVALID_SOCKET)
                 break;
-            nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(data.data()) + pnode->nSendOffset, data.size() - pnode->nSendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+#ifdef WIN32
+            nRequested = it->size() - pnode->nSendOffset;
+            nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(it->data()) + pnode->nSendOffset, nRequested, MSG_NOSIGNAL | MSG_DONTWAIT);
+#else
+            // Gather as many queued buffers as possible (usually headers and payloads of multiple messages) into a
+            // single syscall
+            std::array<struct iovec, MAX_SEND_IOV> iov;
+            size_t nIov = 0;
+            for (auto it2 = it; it2 != pnode->vSendMsg.end() && nIov < iov.size(); ++it2, ++nIov) {
+                const size_t nOffset = nIov == 0 ? pnode->nSendOffset : 0;
+                iov[nIov].iov_base = const_cast<unsigned char*>(it2->data()) + nOffset;
+                iov[nIov].iov_len = it2->size() - nOffset;
+                nRequested += iov[nIov].iov_len;
+            }
+            struct msghdr msg = {};
+            msg.msg_iov = iov.data();
+            msg.msg_iovlen = nIov;
+            nBytes = sendmsg(pnode->hSocket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+#endif
         }
         if (nBytes > 0) {
             pnode->nLastSend = GetSystemTimeInSeconds();
             pnode->nSendBytes += nBytes;
-            pnode->nSendOffset += nBytes;
             nSentSize += nBytes;
-            if (pnode->nSendOffset == data.size()) {
+            size_t nRemaining = nBytes;
+            while (nRemaining > 0) {
+                const size_t nLeft = it->size() - pnode->nSendOffset;
+                if (nRemaining < nLeft) {
+                    pnode->nSendOffset += nRemaining;
+                    break;
+                }
+                nRemaining -= nLeft;
                 pnode->nSendOffset = 0;
-                pnode->nSendSize -= data.size();
-                pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+                pnode->nSendSize -= it->size();
                 it++;
-            } else {
-                // could not send full message; stop sending more
+            }
+            pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+            if ((size_t)nBytes < nRequested) {
+                // could not send everything; stop sending more
                 pnode->fCanSendData = false;
                 break;
             }
@@ -1838,7 +1904,15 @@ size_t CConnman::SocketRecvData(CNode *pnode)
             }
             {
                 LOCK(pnode->cs_vProcessMsg);
-                pnode->vProcessMsg.splice(pnode->vProcessMsg.end(), pnode->vRecvMsg, pnode->vRecvMsg.begin(), it);
+                if (pnode->fSuccessfullyConnected) {
+                    while (pnode->vRecvMsg.begin() != it) {
+                        auto& vTarget = pnode->vRecvMsg.front().m_valid_header && IsPriorityNetMessageType(pnode->vRecvMsg.front().m_command)
+                                        ? pnode->vProcessMsgPriority : pnode->vProcessMsg;
+                        vTarget.splice(vTarget.end(), pnode->vRecvMsg, pnode->vRecvMsg.begin());
+                    }
+                } else {
+                    pnode->vProcessMsg.splice(pnode->vProcessMsg.end(), pnode->vRecvMsg, pnode->vRecvMsg.begin(), it);
+                }
                 pnode->nProcessQueueSize += nSizeAdded;
                 pnode->fPauseRecv = pnode->nProcessQueueSize > nReceiveFloodSize;
             }
@@ -2605,6 +2679,24 @@ void CConnman::ThreadMessageHandler()
             nLastSendMessagesTimeMasternodes = GetTimeMillis();
         }
 
+        // Priority lane: drain the time critical LLMQ messages of all nodes first, so that these don't have to wait
+        // for a full round of (potentially slow) regular messages from all other nodes
+        for (CNode* pnode : vNodesCopy)
+        {
+            if (pnode->fDisconnect)
+                continue;
+
+            int nPriorityProcessed = 0;
+            while (m_msgproc->ProcessPriorityMessages(pnode, flagInterruptMsgProc)) {
+                if (++nPriorityProcessed >= MAX_PRIORITY_MESSAGES_PER_ROUND) {
+                    fMoreWork = true;
+                    break;
+                }
+            }
+            if (flagInterruptMsgProc)
+                return;
+        }
+
         for (CNode* pnode : vNodesCopy)
         {
             if (pnode->fDisconnect)
@@ -3672,7 +3764,7 @@ bool CConnman::NodeFullyConnected(const CNode* pnode)
 
 void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
-    size_t nMessageSize = msg.data.size();
+    size_t nMessageSize = msg.PayloadSize();
     LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", SanitizeString(msg.command), nMessageSize, pnode->GetId());
 
     // make sure we use the appropriate network transport format
@@ -3680,8 +3772,13 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
     pnode->m_serializer->prepareForTransport(msg, serializedHeader);
 
     size_t nTotalSize = nMessageSize + serializedHeader.size();
-    statsClient.count("bandwidth.message." + SanitizeString(msg.command.c_str()) + ".bytesSent", nTotalSize, 1.0f);
-    statsClient.inc("message.sent." + SanitizeString(msg.command.c_str()), 1.0f);
+    if (auto msgTypeStats = GetNetMsgTypeStats(msg.command)) {
+        msgTypeStats->bytesSent.Add(nTotalSize);
+        msgTypeStats->sent.Inc();
+    } else {
+        statsClient.count("bandwidth.message." + SanitizeString(msg.command.c_str()) + ".bytesSent", nTotalSize, 1.0f);
+        statsClient.inc("message.sent." + SanitizeString(msg.command.c_str()), 1.0f);
+    }
 
     size_t nBytesSent = 0;
     {
@@ -3694,9 +3791,14 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 
         if (pnode->nSendSize > nSendBufferMaxSize)
             pnode->fPauseSend = true;
-        pnode->vSendMsg.push_back(std::move(serializedHeader));
-        if (nMessageSize)
-            pnode->vSendMsg.push_back(std::move(msg.data));
+        pnode->vSendMsg.emplace_back(std::move(serializedHeader));
+        if (nMessageSize) {
+            if (msg.shared_payload) {
+                pnode->vSendMsg.emplace_back(std::move(msg.shared_payload));
+            } else {
+                pnode->vSendMsg.emplace_back(std::move(msg.data));
+            }
+        }
         pnode->nSendMsgSize = pnode->vSendMsg.size();
 
         {
@@ -20,6 +20,7 @@
 #include <protocol.h>
 #include <random.h>
 #include <saltedhasher.h>
+#include <statsd_client.h>
 #include <streams.h>
 #include <sync.h>
 #include <threadinterrupt.h>
@@ -117,6 +118,19 @@ struct AddedNodeInfo
 class CNodeStats;
 class CClientUIInterface;
 
+/**
+ * A serialized message payload which is sent to multiple peers without copying it, e.g. a block. The checksum of
+ * the payload is calculated once when it's created.
+ */
+struct CSharedNetMsgPayload
+{
+    explicit CSharedNetMsgPayload(std::vector<unsigned char>&& _data);
+
+    const std::vector<unsigned char> data;
+    const uint256 hash;
+};
+using CSharedNetMsgPayloadPtr = std::shared_ptr<const CSharedNetMsgPayload>;
+
 struct CSerializedNetMsg
 {
     CSerializedNetMsg() = default;
@@ -128,6 +142,25 @@ struct CSerializedNetMsg
 
     std::vector<unsigned char> data;
     std::string command;
+    // When set, this is sent as payload instead of data
+    CSharedNetMsgPayloadPtr shared_payload;
+
+    size_t PayloadSize() const { return shared_payload ? shared_payload->data.size() : data.size(); }
+};
+
+/** Data queued for sending to a peer, either owned by the queue or shared with the queues of other peers */
+class CSendMsgBuffer
+{
+private:
+    std::vector<unsigned char> owned;
+    CSharedNetMsgPayloadPtr shared;
+
+public:
+    explicit CSendMsgBuffer(std::vector<unsigned char>&& _data) : owned(std::move(_data)) {}
+    explicit CSendMsgBuffer(CSharedNetMsgPayloadPtr _shared) : shared(std::move(_shared)) {}
+
+    const unsigned char* data() const { return shared ? shared->data.data() : owned.data(); }
+    size_t size() const { return shared ? shared->data.size() : owned.size(); }
 };
 
 
@@ -690,6 +723,7 @@ class NetEventsInterface
 {
 public:
     virtual bool ProcessMessages(CNode* pnode, std::atomic<bool>& interrupt) = 0;
+    virtual bool ProcessPriorityMessages(CNode* pnode, std::atomic<bool>& interrupt) = 0;
     virtual bool SendMessages(CNode* pnode) = 0;
     virtual void InitializeNode(CNode* pnode) = 0;
     virtual void FinalizeNode(NodeId id, bool& update_connection_time) = 0;
@@ -753,6 +787,20 @@ extern std::map<CNetAddr, LocalServiceInfo> mapLocalHost GUARDED_BY(cs_mapLocalH
 extern const std::string NET_MESSAGE_COMMAND_OTHER;
 typedef std::map<std::string, uint64_t> mapMsgCmdSize; //command, total bytes
 
+/** statsd counters of a message type, registered once so that their keys aren't built for every message */
+struct CNetMsgTypeStats
+{
+    explicit CNetMsgTypeStats(const std::string& msg_type);
+
+    statsd::Counter bytesReceived;
+    statsd::Counter bytesSent;
+    statsd::Counter received;
+    statsd::Counter sent;
+};
+
+/** Get the statsd counters of a known message type, nullptr for unknown types */
+CNetMsgTypeStats* GetNetMsgTypeStats(const std::string& msg_type);
+
 class CNodeStats
 {
 public:
@@ -914,7 +962,7 @@ public:
     size_t nSendSize{0}; // total size of all vSendMsg entries
     size_t nSendOffset{0}; // offset inside the first vSendMsg already sent
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
-    std::list<std::vector<unsigned char>> vSendMsg GUARDED_BY(cs_vSend);
+    std::list<CSendMsgBuffer> vSendMsg GUARDED_BY(cs_vSend);
     std::atomic<size_t> nSendMsgSize{0};
     CCriticalSection cs_vSend;
     CCriticalSection cs_hSocket;
@@ -922,6 +970,8 @@ public:
 
     CCriticalSection cs_vProcessMsg;
     std::list<CNetMessage> vProcessMsg GUARDED_BY(cs_vProcessMsg);
+    // Messages for which IsPriorityNetMessageType() is true, queued separately once the handshake is done
+    std::list<CNetMessage> vProcessMsgPriority GUARDED_BY(cs_vProcessMsg);
     size_t nProcessQueueSize{0};
 
     CCriticalSection cs_sendProcessing;
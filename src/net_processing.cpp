@@ -33,6 +33,7 @@
 
 #include <list>
 #include <memory>
+#include <unordered_map>
 
 #include <spork.h>
 #include <governance/governance.h>
@@ -1232,6 +1233,101 @@ static std::shared_ptr<const CBlock> most_recent_block GUARDED_BY(cs_most_recent
 static std::shared_ptr<const CBlockHeaderAndShortTxIDs> most_recent_compact_block GUARDED_BY(cs_most_recent_block);
 static uint256 most_recent_block_hash GUARDED_BY(cs_most_recent_block);
 
+/**
+ * Blocks and compact blocks serialized for sending, shared by all peers requesting them. After a new block is
+ * connected most of our peers request it (and often a few blocks before it) at about the same time, which otherwise
+ * means a disk read and a serialization for each of them. Entries are evicted least recently used first once the
+ * total size of the cached payloads exceeds the limit.
+ */
+class CSerializedBlockCache
+{
+private:
+    // block hash, compact
+    using Key = std::pair<uint256, bool>;
+    struct Entry {
+        CSharedNetMsgPayloadPtr payload;
+        std::list<Key>::iterator lruIt;
+    };
+
+    mutable CCriticalSection cs;
+    std::unordered_map<Key, Entry, StaticSaltedHasher> entries GUARDED_BY(cs);
+    // most recently used first
+    std::list<Key> lru GUARDED_BY(cs);
+    size_t nBytes GUARDED_BY(cs){0};
+    const size_t nMaxBytes;
+
+    std::atomic<uint64_t> nHits{0};
+    std::atomic<uint64_t> nMisses{0};
+
+public:
+    explicit CSerializedBlockCache(size_t _nMaxBytes) : nMaxBytes(_nMaxBytes) {}
+
+    CSharedNetMsgPayloadPtr Get(const uint256& blockHash, bool fCompact)
+    {
+        {
+            LOCK(cs);
+            auto it = entries.find(Key(blockHash, fCompact));
+            if (it != entries.end()) {
+                lru.splice(lru.begin(), lru, it->second.lruIt);
+                nHits++;
+                statsClient.inc("blockcache.hits", 1.0f);
+                return it->second.payload;
+            }
+        }
+        nMisses++;
+        statsClient.inc("blockcache.misses", 1.0f);
+        return nullptr;
+    }
+
+    void Insert(const uint256& blockHash, bool fCompact, const CSharedNetMsgPayloadPtr& payload)
+    {
+        LOCK(cs);
+        if (payload->data.size() > nMaxBytes || entries.count(Key(blockHash, fCompact))) {
+            return;
+        }
+        lru.emplace_front(blockHash, fCompact);
+        entries.emplace(lru.front(), Entry{payload, lru.begin()});
+        nBytes += payload->data.size();
+        while (nBytes > nMaxBytes) {
+            auto it = entries.find(lru.back());
+            nBytes -= it->second.payload->data.size();
+            entries.erase(it);
+            lru.pop_back();
+        }
+        statsClient.gauge("blockcache.bytes", nBytes, 1.0f);
+    }
+
+    CSerializedBlockCacheStats GetStats() const
+    {
+        CSerializedBlockCacheStats stats;
+        LOCK(cs);
+        stats.nEntries = entries.size();
+        stats.nBytes = nBytes;
+        stats.nMaxBytes = nMaxBytes;
+        stats.nHits = nHits;
+        stats.nMisses = nMisses;
+        return stats;
+    }
+};
+
+static CSerializedBlockCache g_serialized_block_cache(SERIALIZED_BLOCK_CACHE_SIZE);
+
+CSerializedBlockCacheStats GetSerializedBlockCacheStats()
+{
+    return g_serialized_block_cache.GetStats();
+}
+
+/** Serialize a block or compact block once for all peers, neither depends on the protocol version of the peer */
+template <typename T>
+static CSharedNetMsgPayloadPtr MakeSharedBlockPayload(const uint256& blockHash, bool fCompact, const T& obj)
+{
+    std::vector<unsigned char> data;
+    CVectorWriter{SER_NETWORK, PROTOCOL_VERSION, data, 0, obj};
+    auto payload = std::make_shared<const CSharedNetMsgPayload>(std::move(data));
+    g_serialized_block_cache.Insert(blockHash, fCompact, payload);
+    return payload;
+}
+
 /**
  * Maintain state about the best-seen block and fast-announce a compact block
  * to compatible peers.
@@ -1256,9 +1352,11 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
         most_recent_compact_block = pcmpctblock;
     }
 
-    connman->ForEachNode([this, &pcmpctblock, pindex, &msgMaker, &hashBlock](CNode* pnode) {
+    // Only serialized once the first peer wants the compact block, most of the time there is none
+    CSharedNetMsgPayloadPtr cmpctblockPayload;
+
+    connman->ForEachNode([this, &cmpctblockPayload, &pcmpctblock, pindex, &msgMaker, &hashBlock](CNode* pnode) {
         AssertLockHeld(cs_main);
-        // TODO: Avoid the repeated-serialization here
         if (pnode->fDisconnect)
             return;
         ProcessBlockAvailability(pnode->GetId());
@@ -1270,7 +1368,10 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
 
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerLogicValidation::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
-            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock));
+            if (!cmpctblockPayload) {
+                cmpctblockPayload = MakeSharedBlockPayload(hashBlock, true, *pcmpctblock);
+            }
+            connman->PushMessage(pnode, msgMaker.MakeShared(NetMsgType::CMPCTBLOCK, cmpctblockPayload));
             state.pindexBestHeaderSent = pindex;
         }
     });
@@ -1563,8 +1664,24 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
     // it's available before trying to send.
     if (send && (pindex->nStatus & BLOCK_HAVE_DATA))
     {
+        // If a peer is asking for old blocks, we're almost guaranteed
+        // they won't have a useful mempool to match against a compact block,
+        // and we don't feel like constructing the object for them, so
+        // instead we respond with the full, non-compact block.
+        const bool fCompact = inv.type == MSG_CMPCT_BLOCK && CanDirectFetch(consensusParams) &&
+                              pindex->nHeight >= ::ChainActive().Height() - MAX_CMPCTBLOCK_DEPTH;
+        const char* msgType = fCompact ? NetMsgType::CMPCTBLOCK : NetMsgType::BLOCK;
+
+        // Full and compact blocks can be sent without reading the block from disk if another peer requested it recently
+        CSharedNetMsgPayloadPtr payload;
+        if (inv.type == MSG_BLOCK || inv.type == MSG_CMPCT_BLOCK) {
+            payload = g_serialized_block_cache.Get(pindex->GetBlockHash(), fCompact);
+        }
+
         std::shared_ptr<const CBlock> pblock;
-        if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
+        if (payload) {
+            connman->PushMessage(pfrom, msgMaker.MakeShared(msgType, std::move(payload)));
+        } else if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
             pblock = a_recent_block;
         } else {
             // Send block from disk
@@ -1574,9 +1691,7 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
             pblock = pblockRead;
         }
         if (pblock) {
-            if (inv.type == MSG_BLOCK)
-                connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
-            else if (inv.type == MSG_FILTERED_BLOCK) {
+            if (inv.type == MSG_FILTERED_BLOCK) {
                 bool sendMerkleBlock = false;
                 CMerkleBlock merkleBlock;
                 {
@@ -1607,23 +1722,17 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
                 }
                 // else
                 // no response
-            } else if (inv.type == MSG_CMPCT_BLOCK) {
-                // If a peer is asking for old blocks, we're almost guaranteed
-                // they won't have a useful mempool to match against a compact block,
-                // and we don't feel like constructing the object for them, so
-                // instead we respond with the full, non-compact block.
-                if (CanDirectFetch(consensusParams) &&
-                    pindex->nHeight >= ::ChainActive().Height() - MAX_CMPCTBLOCK_DEPTH) {
-                    if (a_recent_compact_block &&
-                        a_recent_compact_block->header.GetHash() == pindex->GetBlockHash()) {
-                        connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::CMPCTBLOCK, *a_recent_compact_block));
-                    } else {
-                        CBlockHeaderAndShortTxIDs cmpctblock(*pblock);
-                        connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::CMPCTBLOCK, cmpctblock));
-                    }
+            } else if (fCompact) {
+                if (a_recent_compact_block &&
+                    a_recent_compact_block->header.GetHash() == pindex->GetBlockHash()) {
+                    payload = MakeSharedBlockPayload(pindex->GetBlockHash(), true, *a_recent_compact_block);
                 } else {
-                    connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
+                    payload = MakeSharedBlockPayload(pindex->GetBlockHash(), true, CBlockHeaderAndShortTxIDs(*pblock));
                 }
+                connman->PushMessage(pfrom, msgMaker.MakeShared(msgType, std::move(payload)));
+            } else if (inv.type == MSG_BLOCK || inv.type == MSG_CMPCT_BLOCK) {
+                payload = MakeSharedBlockPayload(pindex->GetBlockHash(), false, *pblock);
+                connman->PushMessage(pfrom, msgMaker.MakeShared(msgType, std::move(payload)));
             }
         }
         // Trigger the peer node to send a getblocks request for the next batch of inventory
@@ -2414,7 +2523,11 @@ std::pair<bool /*ret*/, bool /*do_return*/> static ValidateDSTX(CCoinJoinBroadca
 bool static ProcessMessage(CNode* pfrom, const std::string& msg_type, CDataStream& vRecv, int64_t nTimeReceived, const CChainParams& chainparams, CConnman* connman, const std::atomic<bool>& interruptMsgProc, bool enable_bip61)
 {
     LogPrint(BCLog::NET, "received: %s (%u bytes) peer=%d\n", SanitizeString(msg_type), vRecv.size(), pfrom->GetId());
-    statsClient.inc("message.received." + SanitizeString(msg_type), 1.0f);
+    if (auto msgTypeStats = GetNetMsgTypeStats(msg_type)) {
+        msgTypeStats->received.Inc();
+    } else {
+        statsClient.inc("message.received." + SanitizeString(msg_type), 1.0f);
+    }
 
     if (gArgs.IsArgSet("-dropmessagestest") && GetRand(gArgs.GetArg("-dropmessagestest", 0)) == 0)
     {
@@ -3917,10 +4030,10 @@ bool static ProcessMessage(CNode* pfrom, const std::string& msg_type, CDataStrea
 
         LOCK(cs_main);
 
-        CSimplifiedMNListDiff mnListDiff;
+        std::shared_ptr<const CSimplifiedMNListDiff> mnListDiff;
         std::string strError;
         if (BuildSimplifiedMNListDiff(cmd.baseBlockHash, cmd.blockHash, mnListDiff, strError)) {
-            connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::MNLISTDIFF, mnListDiff));
+            connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::MNLISTDIFF, *mnListDiff));
         } else {
             strError = strprintf("getmnlistdiff failed for baseBlockHash=%s, blockHash=%s. error=%s", cmd.baseBlockHash.ToString(), cmd.blockHash.ToString(), strError);
             Misbehaving(pfrom->GetId(), 1, strError);
@@ -4076,14 +4189,6 @@ bool PeerLogicValidation::SendRejectsAndCheckIfBanned(CNode* pnode, bool enable_
 bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
 {
     const CChainParams& chainparams = Params();
-    //
-    // Message format
-    //  (4) message start
-    //  (12) command
-    //  (4) size
-    //  (4) checksum
-    //  (x) data
-    //
     bool fMoreWork = false;
 
     if (!pfrom->vRecvGetData.empty())
@@ -4109,15 +4214,63 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     std::list<CNetMessage> msgs;
     {
         LOCK(pfrom->cs_vProcessMsg);
-        if (pfrom->vProcessMsg.empty())
+        // Priority messages are usually handled by ProcessPriorityMessages already, but should still go first
+        // if any are left
+        auto& vProcessMsg = pfrom->vProcessMsgPriority.empty() ? pfrom->vProcessMsg : pfrom->vProcessMsgPriority;
+        if (vProcessMsg.empty())
             return false;
         // Just take one message
-        msgs.splice(msgs.begin(), pfrom->vProcessMsg, pfrom->vProcessMsg.begin());
+        msgs.splice(msgs.begin(), vProcessMsg, vProcessMsg.begin());
         pfrom->nProcessQueueSize -= msgs.front().m_raw_message_size;
         pfrom->fPauseRecv = pfrom->nProcessQueueSize > connman->GetReceiveFloodSize();
-        fMoreWork = !pfrom->vProcessMsg.empty();
+        fMoreWork = !pfrom->vProcessMsg.empty() || !pfrom->vProcessMsgPriority.empty();
+    }
+
+    if (!ProcessNetMessage(pfrom, msgs.front(), interruptMsgProc)) {
+        return false;
     }
-    CNetMessage& msg(msgs.front());
+    if (!pfrom->vRecvGetData.empty())
+        fMoreWork = true;
+
+    return fMoreWork;
+}
+
+bool PeerLogicValidation::ProcessPriorityMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
+{
+    if (pfrom->fDisconnect || pfrom->fPauseSend)
+        return false;
+
+    // Same ordering guarantees as in ProcessMessages: pending getdata responses and orphans of this peer go first.
+    // Leave them (and the priority messages queued behind them) to the regular pass.
+    if (!pfrom->vRecvGetData.empty() || !pfrom->orphan_work_set.empty())
+        return false;
+
+    std::list<CNetMessage> msgs;
+    bool fMoreWork;
+    {
+        LOCK(pfrom->cs_vProcessMsg);
+        if (pfrom->vProcessMsgPriority.empty())
+            return false;
+        msgs.splice(msgs.begin(), pfrom->vProcessMsgPriority, pfrom->vProcessMsgPriority.begin());
+        pfrom->nProcessQueueSize -= msgs.front().m_raw_message_size;
+        pfrom->fPauseRecv = pfrom->nProcessQueueSize > connman->GetReceiveFloodSize();
+        fMoreWork = !pfrom->vProcessMsgPriority.empty();
+    }
+
+    return ProcessNetMessage(pfrom, msgs.front(), interruptMsgProc) && fMoreWork;
+}
+
+bool PeerLogicValidation::ProcessNetMessage(CNode* pfrom, CNetMessage& msg, std::atomic<bool>& interruptMsgProc)
+{
+    const CChainParams& chainparams = Params();
+    //
+    // Message format
+    //  (4) message start
+    //  (12) command
+    //  (4) size
+    //  (4) checksum
+    //  (x) data
+    //
 
     msg.SetVersion(pfrom->GetRecvVersion());
     // Check network magic
@@ -4131,7 +4284,7 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     if (!msg.m_valid_header)
     {
         LogPrint(BCLog::NET, "PROCESSMESSAGE: ERRORS IN HEADER %s peer=%d\n", SanitizeString(msg.m_command), pfrom->GetId());
-        return fMoreWork;
+        return true;
     }
     const std::string& msg_type = msg.m_command;
 
@@ -4144,7 +4297,7 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     {
         LogPrint(BCLog::NET, "%s(%s, %u bytes): CHECKSUM ERROR peer=%d\n", __func__,
            SanitizeString(msg_type), nMessageSize, pfrom->GetId());
-        return fMoreWork;
+        return true;
     }
 
     // Process message
@@ -4154,8 +4307,6 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
         fRet = ProcessMessage(pfrom, msg_type, vRecv, msg.m_time, chainparams, connman, interruptMsgProc, m_enable_bip61);
         if (interruptMsgProc)
             return false;
-        if (!pfrom->vRecvGetData.empty())
-            fMoreWork = true;
     }
     catch (const std::ios_base::failure& e)
     {
@@ -4191,7 +4342,7 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     LOCK(cs_main);
     SendRejectsAndCheckIfBanned(pfrom, m_enable_bip61);
 
-    return fMoreWork;
+    return true;
 }
 
 void PeerLogicValidation::ConsiderEviction(CNode *pto, int64_t time_in_seconds)
@@ -4551,21 +4702,24 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                     LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", __func__,
                             vHeaders.front().GetHash().ToString(), pto->GetId());
 
-                    bool fGotBlockFromCache = false;
-                    {
-                        LOCK(cs_most_recent_block);
-                        if (most_recent_block_hash == pBestIndex->GetBlockHash()) {
-                            connman->PushMessage(pto, msgMaker.Make(NetMsgType::CMPCTBLOCK, *most_recent_compact_block));
-                            fGotBlockFromCache = true;
+                    CSharedNetMsgPayloadPtr payload = g_serialized_block_cache.Get(pBestIndex->GetBlockHash(), true);
+                    if (!payload) {
+                        std::shared_ptr<const CBlockHeaderAndShortTxIDs> pcmpctblock;
+                        {
+                            LOCK(cs_most_recent_block);
+                            if (most_recent_block_hash == pBestIndex->GetBlockHash()) {
+                                pcmpctblock = most_recent_compact_block;
+                            }
                         }
+                        if (!pcmpctblock) {
+                            CBlock block;
+                            bool ret = ReadBlockFromDisk(block, pBestIndex, consensusParams);
+                            assert(ret);
+                            pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(block);
+                        }
+                        payload = MakeSharedBlockPayload(pBestIndex->GetBlockHash(), true, *pcmpctblock);
                     }
-                    if (!fGotBlockFromCache) {
-                        CBlock block;
-                        bool ret = ReadBlockFromDisk(block, pBestIndex, consensusParams);
-                        assert(ret);
-                        CBlockHeaderAndShortTxIDs cmpctblock(block);
-                        connman->PushMessage(pto, msgMaker.Make(NetMsgType::CMPCTBLOCK, cmpctblock));
-                    }
+                    connman->PushMessage(pto, msgMaker.MakeShared(NetMsgType::CMPCTBLOCK, std::move(payload)));
                     state.pindexBestHeaderSent = pBestIndex;
                 } else if (state.fPreferHeadersCompressed) {
                     std::vector<CompressibleBlockHeader> vHeadersCompressed;
@@ -22,6 +22,8 @@ static const unsigned int DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN = 100;
 static constexpr bool DEFAULT_ENABLE_BIP61 = true;
 static const bool DEFAULT_PEERBLOOMFILTERS = true;
 static const bool DEFAULT_PEERBLOCKFILTERS = false;
+/** Maximum size in bytes of the blocks and compact blocks kept serialized for serving them to peers */
+static const size_t SERIALIZED_BLOCK_CACHE_SIZE = 32 * 1024 * 1024;
 
 class PeerLogicValidation final : public CValidationInterface, public NetEventsInterface {
 private:
@@ -61,6 +63,15 @@ public:
     */
     bool ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt) override;
     /**
+    * Process a single message from the priority queue of a given node, if any. Nothing is processed while
+    * getdata responses or orphan transactions of the node are pending, these are left to ProcessMessages.
+    *
+    * @param[in]   pfrom           The node which we have received messages from.
+    * @param[in]   interrupt       Interrupt condition for processing threads
+    * @return                      True if there are more priority messages queued for this node
+    */
+    bool ProcessPriorityMessages(CNode* pfrom, std::atomic<bool>& interrupt) override;
+    /**
     * Send queued protocol messages to be sent to a give node.
     *
     * @param[in]   pto             The node which we are sending messages to.
@@ -76,6 +87,9 @@ public:
     void EvictExtraOutboundPeers(int64_t time_in_seconds) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
 private:
+    /** Process a single message taken from one of the queues of a node. Returns false if processing for this node should stop. */
+    bool ProcessNetMessage(CNode* pfrom, CNetMessage& msg, std::atomic<bool>& interrupt);
+
     int64_t m_stale_tip_check_time; //!< Next time to check for stale tip
 
     /** Enable BIP61 (sending reject messages) */
@@ -91,6 +105,17 @@ struct CNodeStateStats {
 
 /** Get statistics from node state */
 bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats);
+
+struct CSerializedBlockCacheStats {
+    size_t nEntries;
+    size_t nBytes;
+    size_t nMaxBytes;
+    uint64_t nHits;
+    uint64_t nMisses;
+};
+
+/** Get statistics of the cache of serialized blocks sent to peers */
+CSerializedBlockCacheStats GetSerializedBlockCacheStats();
 bool IsBanned(NodeId nodeid) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
 // Upstream moved this into net_processing.cpp (13417), however since we use Misbehaving in a number of springbok specific
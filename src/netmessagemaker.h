@@ -30,6 +30,15 @@ public:
         return Make(0, std::move(sCommand), std::forward<Args>(args)...);
     }
 
+    /** Make a message from an already serialized payload, which is shared instead of copied */
+    CSerializedNetMsg MakeShared(std::string sCommand, CSharedNetMsgPayloadPtr payload) const
+    {
+        CSerializedNetMsg msg;
+        msg.command = std::move(sCommand);
+        msg.shared_payload = std::move(payload);
+        return msg;
+    }
+
 private:
     const int nVersion;
 };
@@ -0,0 +1,165 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockstats.h>
+
+#include <coinjoin/coinjoin.h>
+#include <primitives/block.h>
+#include <version.h>
+
+#include <algorithm>
+#include <limits>
+
+// outpoint (needed for the utxo index) + nHeight + fCoinBase
+static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
+
+template<typename T>
+static T CalculateTruncatedMedian(std::vector<T>& scores)
+{
+    size_t size = scores.size();
+    if (size == 0) {
+        return 0;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    if (size % 2 == 0) {
+        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
+    } else {
+        return scores[size / 2];
+    }
+}
+
+void CalculatePercentilesBySize(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_size)
+{
+    if (scores.empty()) {
+        return;
+    }
+
+    std::sort(scores.begin(), scores.end());
+
+    // 10th, 25th, 50th, 75th, and 90th percentile weight units.
+    const double weights[NUM_GETBLOCKSTATS_PERCENTILES] = {
+        total_size / 10.0, total_size / 4.0, total_size / 2.0, (total_size * 3.0) / 4.0, (total_size * 9.0) / 10.0
+    };
+
+    int64_t next_percentile_index = 0;
+    int64_t cumulative_weight = 0;
+    for (const auto& element : scores) {
+        cumulative_weight += element.second;
+        while (next_percentile_index < NUM_GETBLOCKSTATS_PERCENTILES && cumulative_weight >= weights[next_percentile_index]) {
+            result[next_percentile_index] = element.first;
+            ++next_percentile_index;
+        }
+    }
+
+    // Fill any remaining percentiles with the last value.
+    for (int64_t i = next_percentile_index; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
+        result[i] = scores.back().first;
+    }
+}
+
+/** Mixing transactions turn each input into one output of the same denomination */
+static bool IsCoinJoinMixingTx(const CTransaction& tx)
+{
+    if (tx.nType != TRANSACTION_NORMAL || tx.vout.empty() || tx.vin.size() != tx.vout.size()) {
+        return false;
+    }
+    const CAmount denomination = tx.vout[0].nValue;
+    if (!CCoinJoin::IsDenominatedAmount(denomination)) {
+        return false;
+    }
+    return std::all_of(tx.vout.begin(), tx.vout.end(), [denomination](const CTxOut& out) { return out.nValue == denomination; });
+}
+
+bool ComputeBlockStats(const CBlock& block, const BlockPrevoutLookup& lookup_prevout, BlockStats& stats, const BlockStatsSelection& selection)
+{
+    stats = BlockStats{};
+    stats.txs = block.vtx.size();
+    stats.has_fees = static_cast<bool>(lookup_prevout);
+    // The fees need the output totals
+    const bool loop_outputs = selection.total_out || stats.has_fees;
+
+    CAmount min_fee = MAX_MONEY;
+    CAmount min_feerate = MAX_MONEY;
+    int64_t min_tx_size = std::numeric_limits<int64_t>::max();
+    std::vector<CAmount> fee_array;
+    std::vector<std::pair<CAmount, int64_t>> feerate_array;
+    std::vector<int64_t> txsize_array;
+
+    for (size_t n_tx = 0; n_tx < block.vtx.size(); n_tx++) {
+        const CTransaction& tx = *block.vtx[n_tx];
+        stats.outs += tx.vout.size();
+        if (tx.nVersion == 3 && tx.nType != TRANSACTION_NORMAL) {
+            stats.special_txs[tx.nType]++;
+        }
+
+        CAmount tx_total_out = 0;
+        if (loop_outputs) {
+            for (const CTxOut& out : tx.vout) {
+                tx_total_out += out.nValue;
+                stats.utxo_size_inc += GetSerializeSize(out, SER_NETWORK, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
+            }
+        }
+
+        if (tx.IsCoinBase()) {
+            continue;
+        }
+
+        if (IsCoinJoinMixingTx(tx)) {
+            stats.coinjoin_txs++;
+        }
+
+        stats.ins += tx.vin.size(); // Don't count coinbase's fake input
+        stats.total_out += tx_total_out; // Don't count coinbase reward
+
+        int64_t tx_size = 0;
+        if (selection.tx_sizes) {
+            tx_size = tx.GetTotalSize();
+            if (selection.median_tx_size) {
+                txsize_array.push_back(tx_size);
+            }
+            stats.max_tx_size = std::max(stats.max_tx_size, tx_size);
+            min_tx_size = std::min(min_tx_size, tx_size);
+            stats.total_size += tx_size;
+        }
+
+        if (lookup_prevout) {
+            CAmount tx_total_in = 0;
+            for (size_t n_in = 0; n_in < tx.vin.size(); n_in++) {
+                CTxOut prevout;
+                if (!lookup_prevout(n_tx, n_in, prevout)) {
+                    return false;
+                }
+                tx_total_in += prevout.nValue;
+                stats.utxo_size_inc -= GetSerializeSize(prevout, SER_NETWORK, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
+            }
+
+            const CAmount txfee = tx_total_in - tx_total_out;
+            if (!MoneyRange(txfee)) {
+                return false;
+            }
+            if (selection.median_fee) {
+                fee_array.push_back(txfee);
+            }
+            stats.max_fee = std::max(stats.max_fee, txfee);
+            min_fee = std::min(min_fee, txfee);
+            stats.total_fee += txfee;
+
+            const CAmount feerate = tx_size ? txfee / tx_size : 0;
+            if (selection.feerate_percentiles) {
+                feerate_array.emplace_back(feerate, tx_size);
+            }
+            stats.max_feerate = std::max(stats.max_feerate, feerate);
+            min_feerate = std::min(min_feerate, feerate);
+        }
+    }
+
+    stats.min_tx_size = min_tx_size == std::numeric_limits<int64_t>::max() ? 0 : min_tx_size;
+    stats.median_tx_size = CalculateTruncatedMedian(txsize_array);
+    stats.min_fee = min_fee == MAX_MONEY ? 0 : min_fee;
+    stats.min_feerate = min_feerate == MAX_MONEY ? 0 : min_feerate;
+    stats.median_fee = CalculateTruncatedMedian(fee_array);
+    CalculatePercentilesBySize(stats.feerate_percentiles, feerate_array, stats.total_size);
+    return true;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKSTATS_H
+#define BITCOIN_NODE_BLOCKSTATS_H
+
+#include <amount.h>
+#include <serialize.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+class CBlock;
+class CTxOut;
+
+static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
+
+/** Statistics of a block as reported by getblockstats, apart from the ones read from its block index entry */
+struct BlockStats
+{
+    //! Number of transactions, including the coinbase
+    int64_t txs{0};
+    //! Inputs and outputs of all transactions, except the coinbase input
+    int64_t ins{0};
+    int64_t outs{0};
+    //! Sizes and output totals of the transactions, excluding the coinbase
+    int64_t total_size{0};
+    int64_t min_tx_size{0};
+    int64_t max_tx_size{0};
+    int64_t median_tx_size{0};
+    CAmount total_out{0};
+    //! Whether the spent outputs were available, only then the fee stats and utxo_size_inc are set
+    bool has_fees{false};
+    CAmount total_fee{0};
+    CAmount min_fee{0};
+    CAmount max_fee{0};
+    CAmount median_fee{0};
+    CAmount min_feerate{0};
+    CAmount max_feerate{0};
+    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES]{};
+    int64_t utxo_size_inc{0};
+    //! Number of special transactions by type (CTransaction::nType)
+    std::map<uint16_t, int64_t> special_txs;
+    //! Number of CoinJoin mixing transactions
+    int64_t coinjoin_txs{0};
+
+    SERIALIZE_METHODS(BlockStats, obj)
+    {
+        READWRITE(obj.txs, obj.ins, obj.outs, obj.total_size, obj.min_tx_size, obj.max_tx_size, obj.median_tx_size, obj.total_out);
+        READWRITE(obj.has_fees, obj.total_fee, obj.min_fee, obj.max_fee, obj.median_fee, obj.min_feerate, obj.max_feerate);
+        READWRITE(obj.feerate_percentiles[0], obj.feerate_percentiles[1], obj.feerate_percentiles[2], obj.feerate_percentiles[3], obj.feerate_percentiles[4]);
+        READWRITE(obj.utxo_size_inc, obj.special_txs, obj.coinjoin_txs);
+    }
+};
+
+/** The statistics ComputeBlockStats should compute. The ones left out stay zero. */
+struct BlockStatsSelection
+{
+    //! total_out and utxo_size_inc, always computed when the fee stats are
+    bool total_out{true};
+    //! total_size, min/max_tx_size and the size based fee rates
+    bool tx_sizes{true};
+    bool median_tx_size{true};
+    bool median_fee{true};
+    bool feerate_percentiles{true};
+};
+
+/** Look up the output spent by input n_in of transaction n_tx of a block. Returns false if it cannot be found. */
+using BlockPrevoutLookup = std::function<bool(size_t n_tx, size_t n_in, CTxOut& prevout)>;
+
+/**
+ * Compute the statistics of a block. The fee stats and utxo_size_inc are only computed if lookup_prevout is set.
+ * Only the statistics in selection are computed, apart from the transaction and special transaction counts.
+ * Returns false if a spent output could not be looked up.
+ */
+bool ComputeBlockStats(const CBlock& block, const BlockPrevoutLookup& lookup_prevout, BlockStats& stats, const BlockStatsSelection& selection = {});
+
+/** Used by getblockstats to get feerates at different percentiles by weight  */
+void CalculatePercentilesBySize(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_size);
+
+#endif // BITCOIN_NODE_BLOCKSTATS_H
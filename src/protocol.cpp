@@ -8,6 +8,8 @@
 #include <util/strencodings.h>
 #include <util/system.h>
 
+#include <set>
+
 static std::atomic<bool> g_initial_block_download_completed(false);
 
 #define MAKE_MSG(var_name, p2p_name_str)   \
@@ -337,6 +339,24 @@ const std::vector<std::string> &getAllNetMessageTypes()
     return allNetMessageTypesVec;
 }
 
+bool IsPriorityNetMessageType(const std::string& msg_type)
+{
+    // None of these depend on the order in which they are received relative to other message types, only relative
+    // to each other, which is kept as they all share the same queue
+    static const std::set<std::string> priorityNetMessageTypes{
+        NetMsgType::QSIGSESANN,
+        NetMsgType::QSIGSHARESINV,
+        NetMsgType::QGETSIGSHARES,
+        NetMsgType::QBSIGSHARES,
+        NetMsgType::QSIGSHARE,
+        NetMsgType::QSIGREC,
+        NetMsgType::ISLOCK,
+        NetMsgType::ISDLOCK,
+        NetMsgType::CLSIG,
+    };
+    return priorityNetMessageTypes.count(msg_type) != 0;
+}
+
 /**
  * Convert a service flag (NODE_*) to a human readable string.
  * It supports unknown service flags which will be returned as "UNKNOWN[...]".
@@ -306,6 +306,12 @@ extern const char *QUORUMROTATIONINFO;
 /* Get a vector of all valid message types (see above) */
 const std::vector<std::string> &getAllNetMessageTypes();
 
+/**
+ * Time critical LLMQ messages (signature shares, recovered signatures, InstantSend and ChainLocks). These are handled
+ * in a separate lane ahead of other messages, see CConnman::ThreadMessageHandler.
+ */
+bool IsPriorityNetMessageType(const std::string& msg_type);
+
 /** nServices flags */
 enum ServiceFlags : uint64_t {
     // NOTE: When adding here, be sure to update serviceFlagToStr too
@@ -6,11 +6,16 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <core_io.h>
+#include <evo/deterministicmns.h>
 #include <httpserver.h>
 #include <index/txindex.h>
+#include <key_io.h>
+#include <llmq/blockprocessor.h>
+#include <llmq/commitment.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <streams.h>
@@ -64,6 +69,25 @@ static bool RESTERR(HTTPRequest* req, enum HTTPStatusCode status, std::string me
     return false;
 }
 
+/**
+ * Send a JSON reply which is written incrementally by fn. The reply is sent
+ * in chunks while it is being written, so it never exists as a whole in memory.
+ */
+static void WriteJSONReply(HTTPRequest* req, const std::function<void(JSONStreamWriter&)>& fn)
+{
+    JSONStreamWriter stream([req](const std::string& chunk) {
+        if (!req->IsReplyStarted()) {
+            req->WriteHeader("Content-Type", "application/json");
+            req->WriteReplyStart(HTTP_OK);
+        }
+        req->WriteReplyChunk(chunk);
+    });
+    fn(stream);
+    stream.Flush();
+    req->WriteReplyChunk("\n");
+    req->WriteReplyEnd();
+}
+
 static RetFormat ParseDataFormat(std::string& param, const std::string& strReq)
 {
     const std::string::size_type pos = strReq.rfind('.');
@@ -109,6 +133,64 @@ static bool CheckWarmup(HTTPRequest* req)
     return true;
 }
 
+/**
+ * Send obj in the requested format. The binary and hex formats use the
+ * serialization of obj, toJSON is only invoked for JSON replies.
+ */
+template <typename T>
+static bool WriteFormattedReply(HTTPRequest* req, RetFormat rf, const T& obj, const std::function<UniValue()>& toJSON)
+{
+    switch (rf) {
+    case RetFormat::BINARY: {
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << obj;
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, ss.str());
+        return true;
+    }
+
+    case RetFormat::HEX: {
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << obj;
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, HexStr(ss) + "\n");
+        return true;
+    }
+
+    case RetFormat::JSON: {
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, toJSON().write() + "\n");
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+/** Address index key (type 1 for P2PKH and 2 for P2SH, and the hash) of an address */
+static bool ParseAddressIndexKey(const std::string& str, uint160& hashBytes, int& type)
+{
+    CTxDestination dest = DecodeDestination(str);
+    if (const CKeyID* keyID = boost::get<CKeyID>(&dest)) {
+        type = 1;
+        hashBytes = *keyID;
+        return true;
+    }
+    if (const CScriptID* scriptID = boost::get<CScriptID>(&dest)) {
+        type = 2;
+        hashBytes = *scriptID;
+        return true;
+    }
+    return false;
+}
+
+static std::string AddressFromIndexKey(int type, const uint160& hashBytes)
+{
+    return type == 2 ? EncodeDestination(CScriptID(hashBytes)) : EncodeDestination(CKeyID(hashBytes));
+}
+
 static bool rest_headers(HTTPRequest* req,
                          const std::string& strURIPart)
 {
@@ -237,10 +319,9 @@ static bool rest_block(HTTPRequest* req,
     }
 
     case RetFormat::JSON: {
-        UniValue objBlock = blockToJSON(block, tip, pblockindex, showTxDetails);
-        std::string strJSON = objBlock.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        WriteJSONReply(req, [&](JSONStreamWriter& stream) {
+            blockToJSON(stream, block, tip, pblockindex, showTxDetails);
+        });
         return true;
     }
 
@@ -317,11 +398,9 @@ static bool rest_mempool_contents(HTTPRequest* req, const std::string& strURIPar
 
     switch (rf) {
     case RetFormat::JSON: {
-        UniValue mempoolObject = MempoolToJSON(::mempool, true);
-
-        std::string strJSON = mempoolObject.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        WriteJSONReply(req, [](JSONStreamWriter& stream) {
+            MempoolToJSON(stream, ::mempool, true);
+        });
         return true;
     }
     default: {
@@ -616,6 +695,160 @@ static bool rest_blockhash_by_height(HTTPRequest* req,
     }
 }
 
+static bool rest_address_utxos(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string addressStr;
+    const RetFormat rf = ParseDataFormat(addressStr, strURIPart);
+
+    uint160 hashBytes;
+    int type{0};
+    if (!ParseAddressIndexKey(addressStr, hashBytes, type))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid address: " + addressStr);
+    if (!fAddressIndex)
+        return RESTERR(req, HTTP_NOT_FOUND, "Address index not enabled");
+
+    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue>> unspentOutputs;
+    if (!GetAddressUnspent(hashBytes, type, unspentOutputs))
+        return RESTERR(req, HTTP_NOT_FOUND, "No information available for address " + addressStr);
+    std::sort(unspentOutputs.begin(), unspentOutputs.end(), [](const auto& a, const auto& b) {
+        return a.second.blockHeight < b.second.blockHeight;
+    });
+
+    return WriteFormattedReply(req, rf, unspentOutputs, [&] {
+        UniValue result(UniValue::VARR);
+        for (const auto& [key, value] : unspentOutputs) {
+            UniValue output(UniValue::VOBJ);
+            output.pushKV("address", addressStr);
+            output.pushKV("txid", key.txhash.GetHex());
+            output.pushKV("outputIndex", (int)key.index);
+            output.pushKV("script", HexStr(value.script));
+            output.pushKV("satoshis", value.satoshis);
+            output.pushKV("height", value.blockHeight);
+            result.push_back(output);
+        }
+        return result;
+    });
+}
+
+static bool rest_address_deltas(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string addressStr;
+    const RetFormat rf = ParseDataFormat(addressStr, strURIPart);
+
+    uint160 hashBytes;
+    int type{0};
+    if (!ParseAddressIndexKey(addressStr, hashBytes, type))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid address: " + addressStr);
+    if (!fAddressIndex)
+        return RESTERR(req, HTTP_NOT_FOUND, "Address index not enabled");
+
+    std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
+    if (!GetAddressIndex(hashBytes, type, addressIndex))
+        return RESTERR(req, HTTP_NOT_FOUND, "No information available for address " + addressStr);
+
+    return WriteFormattedReply(req, rf, addressIndex, [&] {
+        UniValue result(UniValue::VARR);
+        for (const auto& [key, amount] : addressIndex) {
+            UniValue delta(UniValue::VOBJ);
+            delta.pushKV("satoshis", amount);
+            delta.pushKV("txid", key.txhash.GetHex());
+            delta.pushKV("index", (int)key.index);
+            delta.pushKV("blockindex", (int)key.txindex);
+            delta.pushKV("height", key.blockHeight);
+            delta.pushKV("address", AddressFromIndexKey(key.type, key.hashBytes));
+            result.push_back(delta);
+        }
+        return result;
+    });
+}
+
+static bool rest_spentinfo(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RetFormat rf = ParseDataFormat(param, strURIPart);
+
+    // The output is given as <txid>-<n>, like the outpoints of getutxos
+    const size_t pos = param.find('-');
+    uint256 txid;
+    int32_t outputIndex;
+    if (pos == std::string::npos || !ParseHashStr(param.substr(0, pos), txid) || !ParseInt32(param.substr(pos + 1), &outputIndex) || outputIndex < 0)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid output: " + param);
+    if (!fSpentIndex)
+        return RESTERR(req, HTTP_NOT_FOUND, "Spent index not enabled");
+
+    CSpentIndexKey key(txid, outputIndex);
+    CSpentIndexValue value;
+    if (!GetSpentIndex(key, value))
+        return RESTERR(req, HTTP_NOT_FOUND, param + " not found");
+
+    return WriteFormattedReply(req, rf, value, [&] {
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("txid", value.txid.GetHex());
+        obj.pushKV("index", (int)value.inputIndex);
+        obj.pushKV("height", value.blockHeight);
+        return obj;
+    });
+}
+
+static bool rest_protx(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string hashStr;
+    const RetFormat rf = ParseDataFormat(hashStr, strURIPart);
+
+    uint256 proTxHash;
+    if (!ParseHashStr(hashStr, proTxHash))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
+
+    auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(proTxHash);
+    if (!dmn)
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+
+    return WriteFormattedReply(req, rf, *dmn, [&] {
+        UniValue obj;
+        dmn->ToJson(obj);
+        return obj;
+    });
+}
+
+static bool rest_quorum(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RetFormat rf = ParseDataFormat(param, strURIPart);
+
+    // The quorum is given as <llmqType>/<quorumHash>
+    std::vector<std::string> path;
+    boost::split(path, param, boost::is_any_of("/"));
+    int32_t type;
+    uint256 quorumHash;
+    if (path.size() != 2 || !ParseInt32(path[0], &type) || !ParseHashStr(path[1], quorumHash))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid quorum: " + param);
+    if (type < 0 || type > std::numeric_limits<uint8_t>::max() || !Params().HasLLMQ(static_cast<Consensus::LLMQType>(type)))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid LLMQ type: " + path[0]);
+    const auto llmqType = static_cast<Consensus::LLMQType>(type);
+
+    uint256 minedBlockHash;
+    const auto commitment = llmq::quorumBlockProcessor->GetMinedCommitment(llmqType, quorumHash, minedBlockHash);
+    if (!commitment)
+        return RESTERR(req, HTTP_NOT_FOUND, param + " not found");
+
+    return WriteFormattedReply(req, rf, *commitment, [&] {
+        UniValue obj(UniValue::VOBJ);
+        commitment->ToJson(obj);
+        obj.pushKV("minedBlock", minedBlockHash.GetHex());
+        return obj;
+    });
+}
+
 static const struct {
     const char* prefix;
     bool (*handler)(HTTPRequest* req, const std::string& strReq);
@@ -629,6 +862,11 @@ static const struct {
       {"/rest/headers/", rest_headers},
       {"/rest/getutxos", rest_getutxos},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      {"/rest/addressutxos/", rest_address_utxos},
+      {"/rest/addressdeltas/", rest_address_deltas},
+      {"/rest/spentinfo/", rest_spentinfo},
+      {"/rest/protx/", rest_protx},
+      {"/rest/quorum/", rest_quorum},
 };
 
 void StartREST()
@@ -14,18 +14,24 @@
 #include <core_io.h>
 #include <consensus/validation.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/txindex.h>
 #include <key_io.h>
+#include <node/blockstats.h>
 #include <node/coinstats.h>
 #include <policy/feerate.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
+#include <rpc/statuscache.h>
 #include <rpc/util.h>
+#include <saltedhasher.h>
 #include <script/descriptor.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
+#include <unordered_lru_cache.h>
 #include <util/strencodings.h>
 #include <util/validation.h>
 #include <util/system.h>
@@ -46,6 +52,7 @@
 
 #include <boost/thread/thread.hpp> // boost::thread::interrupt
 
+#include <future>
 #include <mutex>
 #include <condition_variable>
 #include <merkleblock.h>
@@ -125,62 +132,182 @@ UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex
     return result;
 }
 
-UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, bool txDetails, bool powHash)
+/** Fill the fields of a block's JSON object which come before (header) and after (trailer) its "tx" array */
+static void blockFieldsToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, bool chainLock, bool powHash, UniValue& header, UniValue& trailer)
 {
-    UniValue result(UniValue::VOBJ);
-    result.pushKV("hash", blockindex->GetBlockHash().GetHex());
+    header.pushKV("hash", blockindex->GetBlockHash().GetHex());
     const CBlockIndex* pnext;
     int confirmations = ComputeNextBlockAndDepth(tip, blockindex, pnext);
-    result.pushKV("confirmations", confirmations);
-    result.pushKV("size", (int)::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION));
-    result.pushKV("height", blockindex->nHeight);
-    result.pushKV("version", block.nVersion);
-    result.pushKV("versionHex", strprintf("%08x", block.nVersion));
-    result.pushKV("merkleroot", block.hashMerkleRoot.GetHex());
-    bool chainLock = llmq::chainLocksHandler->HasChainLock(blockindex->nHeight, blockindex->GetBlockHash());
-    UniValue txs(UniValue::VARR);
-    for(const auto& tx : block.vtx)
-    {
-        if(txDetails)
-        {
-            UniValue objTx(UniValue::VOBJ);
-            TxToUniv(*tx, uint256(), objTx, true);
-            bool fLocked = llmq::quorumInstantSendManager->IsLocked(tx->GetHash());
-            objTx.pushKV("instantlock", fLocked || chainLock);
-            objTx.pushKV("instantlock_internal", fLocked);
-            txs.push_back(objTx);
-        }
-        else
-            txs.push_back(tx->GetHash().GetHex());
-    }
-    result.pushKV("tx", txs);
+    header.pushKV("confirmations", confirmations);
+    header.pushKV("size", (int)::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION));
+    header.pushKV("height", blockindex->nHeight);
+    header.pushKV("version", block.nVersion);
+    header.pushKV("versionHex", strprintf("%08x", block.nVersion));
+    header.pushKV("merkleroot", block.hashMerkleRoot.GetHex());
+
     if (!block.vtx[0]->vExtraPayload.empty()) {
         CCbTx cbTx;
         if (GetTxPayload(block.vtx[0]->vExtraPayload, cbTx)) {
             UniValue cbTxObj;
             cbTx.ToJson(cbTxObj);
-            result.pushKV("cbTx", cbTxObj);
+            trailer.pushKV("cbTx", cbTxObj);
         }
     }
-    result.pushKV("time", block.GetBlockTime());
-    result.pushKV("mediantime", (int64_t)blockindex->GetMedianTimePast());
-    result.pushKV("nonce", (uint64_t)block.nNonce);
-    result.pushKV("bits", strprintf("%08x", block.nBits));
-    result.pushKV("difficulty", GetDifficulty(blockindex));
-    result.pushKV("chainwork", blockindex->nChainWork.GetHex());
-    result.pushKV("nTx", (uint64_t)blockindex->nTx);
+    trailer.pushKV("time", block.GetBlockTime());
+    trailer.pushKV("mediantime", (int64_t)blockindex->GetMedianTimePast());
+    trailer.pushKV("nonce", (uint64_t)block.nNonce);
+    trailer.pushKV("bits", strprintf("%08x", block.nBits));
+    trailer.pushKV("difficulty", GetDifficulty(blockindex));
+    trailer.pushKV("chainwork", blockindex->nChainWork.GetHex());
+    trailer.pushKV("nTx", (uint64_t)blockindex->nTx);
 
     if (blockindex->pprev)
-        result.pushKV("previousblockhash", blockindex->pprev->GetBlockHash().GetHex());
+        trailer.pushKV("previousblockhash", blockindex->pprev->GetBlockHash().GetHex());
     if (pnext)
-        result.pushKV("nextblockhash", pnext->GetBlockHash().GetHex());
+        trailer.pushKV("nextblockhash", pnext->GetBlockHash().GetHex());
 
-    result.pushKV("chainlock", chainLock);
+    trailer.pushKV("chainlock", chainLock);
     if(powHash)
-        result.pushKV("powhash", block.GetPOWHash().GetHex());
+        trailer.pushKV("powhash", block.GetPOWHash().GetHex());
+}
+
+/** Minimum number of transactions of a block for decoding them in parallel */
+static constexpr size_t BLOCK_TX_JSON_PARALLEL_MIN_SIZE = 16;
+/** Number of blocks whose decoded transactions are memoized */
+static constexpr size_t BLOCK_TX_JSON_CACHE_SIZE = 8;
+
+using BlockTxJSONPtr = std::shared_ptr<const std::vector<UniValue>>;
+
+/** Decoded transactions of recently requested blocks, without the instantlock fields which change over time */
+static Mutex cs_block_tx_json_cache;
+// The cache is truncated to its max size once it exceeds the threshold, before adding an entry
+static unordered_lru_cache<uint256, BlockTxJSONPtr, StaticSaltedHasher, BLOCK_TX_JSON_CACHE_SIZE - 1, BLOCK_TX_JSON_CACHE_SIZE - 1> g_block_tx_json_cache GUARDED_BY(cs_block_tx_json_cache);
+/** Blocks which are being decoded, so that concurrent requests for a block wait for the same decoding */
+static std::map<uint256, std::shared_future<BlockTxJSONPtr>> g_block_tx_json_pending GUARDED_BY(cs_block_tx_json_cache);
+
+static BlockTxJSONPtr GetBlockTxsJSON(const CBlock& block, const uint256& blockHash)
+{
+    std::promise<BlockTxJSONPtr> promise;
+    std::shared_future<BlockTxJSONPtr> pending;
+    {
+        LOCK(cs_block_tx_json_cache);
+        BlockTxJSONPtr txs;
+        if (g_block_tx_json_cache.get(blockHash, txs)) {
+            return txs;
+        }
+        auto it = g_block_tx_json_pending.find(blockHash);
+        if (it != g_block_tx_json_pending.end()) {
+            pending = it->second;
+        } else {
+            g_block_tx_json_pending.emplace(blockHash, promise.get_future().share());
+        }
+    }
+    if (pending.valid()) {
+        // The decoding thread doesn't depend on other threads to finish, see RPCParallelFor
+        return pending.get();
+    }
+
+    BlockTxJSONPtr txs;
+    try {
+        auto decoded = std::make_shared<std::vector<UniValue>>(block.vtx.size(), UniValue(UniValue::VOBJ));
+        auto decode = [&](size_t i) { TxToUniv(*block.vtx[i], uint256(), (*decoded)[i], true); };
+        if (block.vtx.size() >= BLOCK_TX_JSON_PARALLEL_MIN_SIZE) {
+            RPCParallelFor(block.vtx.size(), decode);
+        } else {
+            for (size_t i = 0; i < block.vtx.size(); ++i) {
+                decode(i);
+            }
+        }
+        txs = decoded;
+    } catch (...) {
+        WITH_LOCK(cs_block_tx_json_cache, g_block_tx_json_pending.erase(blockHash));
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    {
+        LOCK(cs_block_tx_json_cache);
+        g_block_tx_json_cache.insert(blockHash, txs);
+        g_block_tx_json_pending.erase(blockHash);
+    }
+    promise.set_value(txs);
+    return txs;
+}
+
+/**
+ * Call fn for each element of a block's "tx" array, in order. The element is made of the key/value pairs of
+ * both arguments: the memoized decoded transaction and its instantlock fields. Without txDetails, the element
+ * is the txid and the second argument is null.
+ */
+static void blockTxsToJSON(const CBlock& block, const CBlockIndex* blockindex, bool txDetails, bool chainLock,
+                           const std::function<void(const UniValue& tx, const UniValue& instantlock)>& fn)
+{
+    if (!txDetails) {
+        for (const auto& tx : block.vtx) {
+            fn(tx->GetHash().GetHex(), NullUniValue);
+        }
+        return;
+    }
+
+    const BlockTxJSONPtr txs = GetBlockTxsJSON(block, blockindex->GetBlockHash());
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        bool fLocked = llmq::quorumInstantSendManager->IsLocked(block.vtx[i]->GetHash());
+        UniValue instantlock(UniValue::VOBJ);
+        instantlock.pushKV("instantlock", fLocked || chainLock);
+        instantlock.pushKV("instantlock_internal", fLocked);
+        fn((*txs)[i], instantlock);
+    }
+}
+
+UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, bool txDetails, bool powHash)
+{
+    bool chainLock = llmq::chainLocksHandler->HasChainLock(blockindex->nHeight, blockindex->GetBlockHash());
+    UniValue result(UniValue::VOBJ);
+    UniValue trailer(UniValue::VOBJ);
+    blockFieldsToJSON(block, tip, blockindex, chainLock, powHash, result, trailer);
+
+    UniValue txs(UniValue::VARR);
+    blockTxsToJSON(block, blockindex, txDetails, chainLock, [&](const UniValue& tx, const UniValue& instantlock) {
+        if (instantlock.isNull()) {
+            txs.push_back(tx);
+            return;
+        }
+        // The memoized transaction is copied once here, UniValue can't move it into the array
+        UniValue objTx = tx;
+        objTx.pushKVs(instantlock);
+        txs.push_back(objTx);
+    });
+    result.pushKV("tx", txs);
+    result.pushKVs(trailer);
     return result;
 }
 
+void blockToJSON(JSONStreamWriter& stream, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, bool txDetails, bool powHash)
+{
+    bool chainLock = llmq::chainLocksHandler->HasChainLock(blockindex->nHeight, blockindex->GetBlockHash());
+    UniValue header(UniValue::VOBJ);
+    UniValue trailer(UniValue::VOBJ);
+    blockFieldsToJSON(block, tip, blockindex, chainLock, powHash, header, trailer);
+
+    stream.BeginObject();
+    stream.KeyValues(header);
+    stream.Key("tx");
+    stream.BeginArray();
+    blockTxsToJSON(block, blockindex, txDetails, chainLock, [&](const UniValue& tx, const UniValue& instantlock) {
+        if (instantlock.isNull()) {
+            stream.Value(tx);
+            return;
+        }
+        // Written straight from the memo, without copying it
+        stream.BeginObject();
+        stream.KeyValues(tx);
+        stream.KeyValues(instantlock);
+        stream.EndObject();
+    });
+    stream.EndArray();
+    stream.KeyValues(trailer);
+    stream.EndObject();
+}
+
 static UniValue getblockcount(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() != 0)
@@ -255,6 +382,51 @@ static UniValue getbestchainlock(const JSONRPCRequest& request)
     return result;
 }
 
+static UniValue getchainlockstats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            RPCHelpMan{"getchainlockstats",
+                "\nReturns statistics about the ChainLock signing pipeline of this node.",
+                {},
+                RPCResult{
+                    "{\n"
+                    "  \"sign_attempts\" : n,             (numeric) Number of attempts to sign a new tip\n"
+                    "  \"sign_attempts_waiting\" : n,     (numeric) Number of attempts which had to wait for islocks\n"
+                    "  \"sign_requests\" : n,             (numeric) Number of tips we actually tried to sign\n"
+                    "  \"chainlocks_processed\" : n,      (numeric) Number of new best CLSIGs processed\n"
+                    "  \"last_block_to_sign_ms\" : n,     (numeric) Time from block connection to our sign request for the last signed tip, -1 if unknown\n"
+                    "  \"last_block_to_chainlock_ms\" : n,(numeric) Time from block connection to CLSIG for the last CLSIG, -1 if unknown\n"
+                    "  \"avg_block_to_chainlock_ms\" : n, (numeric) Average time from block connection to CLSIG, -1 if unknown\n"
+                    "  \"max_block_to_chainlock_ms\" : n, (numeric) Maximum time from block connection to CLSIG, -1 if unknown\n"
+                    "  \"tracked_blocks\" : n,            (numeric) Number of not yet ChainLocked blocks being tracked\n"
+                    "  \"unlocked_txs\" : n,              (numeric) Number of TXs in tracked blocks which are neither islocked nor old enough\n"
+                    "  \"tip_unlocked_txs\" : n,          (numeric) Same as unlocked_txs, but only for the current tip\n"
+                    "}\n"
+                },
+                RPCExamples{
+                    HelpExampleCli("getchainlockstats", "")
+                    + HelpExampleRpc("getchainlockstats", "")
+                },
+            }.ToString());
+
+    const llmq::CChainLocksStats stats = llmq::chainLocksHandler->GetStats();
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("sign_attempts", stats.nSignAttempts);
+    result.pushKV("sign_attempts_waiting", stats.nSignAttemptsWaiting);
+    result.pushKV("sign_requests", stats.nSignRequests);
+    result.pushKV("chainlocks_processed", stats.nChainLocksProcessed);
+    result.pushKV("last_block_to_sign_ms", stats.nLastBlockToSignMs);
+    result.pushKV("last_block_to_chainlock_ms", stats.nLastBlockToChainLockMs);
+    result.pushKV("avg_block_to_chainlock_ms", stats.nBlockToChainLockSamples == 0 ? -1 : stats.nTotalBlockToChainLockMs / (int64_t)stats.nBlockToChainLockSamples);
+    result.pushKV("max_block_to_chainlock_ms", stats.nMaxBlockToChainLockMs);
+    result.pushKV("tracked_blocks", (uint64_t)stats.nTrackedBlocks);
+    result.pushKV("unlocked_txs", (uint64_t)stats.nUnlockedTxs);
+    result.pushKV("tip_unlocked_txs", (uint64_t)stats.nTipUnlockedTxs);
+    return result;
+}
+
 void RPCNotifyBlockChange(bool ibd, const CBlockIndex * pindex)
 {
     if(pindex) {
@@ -464,10 +636,9 @@ static std::string EntryDescriptionString()
            "    \"instantlock\" : true|false  (boolean) True if this transaction was locked via InstantSend\n";
 }
 
-static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+/** Describe a mempool entry, given the txids of its in-mempool parents and children */
+static void entryToJSON(UniValue& info, const CTxMemPoolEntry& e, const std::vector<uint256>& vParents, const std::vector<uint256>& vChildren)
 {
-    AssertLockHeld(pool.cs);
-
     UniValue fees(UniValue::VOBJ);
     fees.pushKV("base", ValueFromAmount(e.GetFee()));
     fees.pushKV("modified", ValueFromAmount(e.GetModifiedFee()));
@@ -489,10 +660,9 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("ancestorfees", e.GetModFeesWithAncestors());
     const CTransaction& tx = e.GetTx();
     std::set<std::string> setDepends;
-    for (const CTxIn& txin : tx.vin)
+    for (const uint256& parent : vParents)
     {
-        if (pool.exists(txin.prevout.hash))
-            setDepends.insert(txin.prevout.hash.ToString());
+        setDepends.insert(parent.ToString());
     }
 
     UniValue depends(UniValue::VARR);
@@ -504,41 +674,77 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("depends", depends);
 
     UniValue spent(UniValue::VARR);
-    const CTxMemPool::txiter& it = pool.mapTx.find(tx.GetHash());
-    const CTxMemPool::setEntries& setChildren = pool.GetMemPoolChildren(it);
-    for (CTxMemPool::txiter childiter : setChildren) {
-        spent.push_back(childiter->GetTx().GetHash().ToString());
+    for (const uint256& child : vChildren) {
+        spent.push_back(child.ToString());
     }
 
     info.pushKV("spentby", spent);
     info.pushKV("instantlock", llmq::quorumInstantSendManager->IsLocked(tx.GetHash()));
 }
 
+static void entryToJSON(UniValue& info, const CTxMemPoolSnapshotEntry& snapshot_entry)
+{
+    entryToJSON(info, snapshot_entry.entry, snapshot_entry.vParents, snapshot_entry.vChildren);
+}
+
+static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+{
+    AssertLockHeld(pool.cs);
+
+    const CTxMemPool::txiter it = pool.mapTx.find(e.GetTx().GetHash());
+    std::vector<uint256> vParents;
+    for (CTxMemPool::txiter parentiter : pool.GetMemPoolParents(it)) {
+        vParents.push_back(parentiter->GetTx().GetHash());
+    }
+    std::vector<uint256> vChildren;
+    for (CTxMemPool::txiter childiter : pool.GetMemPoolChildren(it)) {
+        vChildren.push_back(childiter->GetTx().GetHash());
+    }
+    entryToJSON(info, e, vParents, vChildren);
+}
+
+/** Call fn with the txid and, if verbose, the JSON object of each mempool entry */
+static void mempoolEntriesToJSON(const CTxMemPool& pool, bool verbose, const std::function<void(const std::string& txid, const UniValue& info)>& fn)
+{
+    // Build the reply from a snapshot, without holding pool.cs
+    const auto snapshot = pool.GetSnapshot();
+    for (const CTxMemPoolSnapshotEntry& e : snapshot->vEntries) {
+        UniValue info;
+        if (verbose) {
+            info.setObject();
+            entryToJSON(info, e);
+        }
+        fn(e.entry.GetTx().GetHash().ToString(), info);
+    }
+}
+
 UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose)
 {
-    if (verbose) {
-        LOCK(pool.cs);
-        UniValue o(UniValue::VOBJ);
-        for (const CTxMemPoolEntry& e : pool.mapTx) {
-            const uint256& hash = e.GetTx().GetHash();
-            UniValue info(UniValue::VOBJ);
-            entryToJSON(pool, info, e);
+    UniValue o(verbose ? UniValue::VOBJ : UniValue::VARR);
+    mempoolEntriesToJSON(pool, verbose, [&](const std::string& txid, const UniValue& info) {
+        if (verbose) {
             // Mempool has unique entries so there is no advantage in using
             // UniValue::pushKV, which checks if the key already exists in O(N).
             // UniValue::__pushKV is used instead which currently is O(1).
-            o.__pushKV(hash.ToString(), info);
+            o.__pushKV(txid, info);
+        } else {
+            o.push_back(txid);
         }
-        return o;
-    } else {
-        std::vector<uint256> vtxid;
-        pool.queryHashes(vtxid);
-
-        UniValue a(UniValue::VARR);
-        for (const uint256& hash : vtxid)
-            a.push_back(hash.ToString());
+    });
+    return o;
+}
 
-        return a;
-    }
+void MempoolToJSON(JSONStreamWriter& stream, const CTxMemPool& pool, bool verbose)
+{
+    verbose ? stream.BeginObject() : stream.BeginArray();
+    mempoolEntriesToJSON(pool, verbose, [&](const std::string& txid, const UniValue& info) {
+        if (verbose) {
+            stream.KeyValue(txid, info);
+        } else {
+            stream.Value(txid);
+        }
+    });
+    verbose ? stream.EndObject() : stream.EndArray();
 }
 
 static UniValue getrawmempool(const JSONRPCRequest& request)
@@ -573,6 +779,10 @@ static UniValue getrawmempool(const JSONRPCRequest& request)
     if (!request.params[0].isNull())
         fVerbose = request.params[0].get_bool();
 
+    if (request.stream) {
+        MempoolToJSON(*request.stream, ::mempool, fVerbose);
+        return NullUniValue;
+    }
     return MempoolToJSON(::mempool, fVerbose);
 }
 
@@ -640,7 +850,8 @@ static UniValue getmempoolancestors(const JSONRPCRequest& request)
             const uint256& _hash = e.GetTx().GetHash();
             UniValue info(UniValue::VOBJ);
             entryToJSON(::mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            // Mempool entries in the set are unique, see MempoolToJSON
+            o.__pushKV(_hash.ToString(), info);
         }
         return o;
     }
@@ -710,7 +921,8 @@ static UniValue getmempooldescendants(const JSONRPCRequest& request)
             const uint256& _hash = e.GetTx().GetHash();
             UniValue info(UniValue::VOBJ);
             entryToJSON(::mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            // Mempool entries in the set are unique, see MempoolToJSON
+            o.__pushKV(_hash.ToString(), info);
         }
         return o;
     }
@@ -1141,8 +1353,6 @@ static UniValue getblock(const JSONRPCRequest& request)
                 },
             }.ToString());
 
-    LOCK(cs_main);
-
     std::string strHash = request.params[0].get_str();
     uint256 hash(uint256S(strHash));
 
@@ -1163,12 +1373,20 @@ static UniValue getblock(const JSONRPCRequest& request)
 		}
 	}
 
-    const CBlockIndex* pblockindex = LookupBlockIndex(hash);
-    if (!pblockindex) {
-        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
-    }
+    // Don't hold cs_main while building the reply: writing a streamed reply waits for the client
+    CBlock block;
+    const CBlockIndex* pblockindex;
+    const CBlockIndex* tip;
+    {
+        LOCK(cs_main);
+        pblockindex = LookupBlockIndex(hash);
+        tip = ::ChainActive().Tip();
+        if (!pblockindex) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
+        }
 
-    const CBlock block = GetBlockChecked(pblockindex);
+        block = GetBlockChecked(pblockindex);
+    }
 
     if (verbosity <= 0)
     {
@@ -1178,7 +1396,11 @@ static UniValue getblock(const JSONRPCRequest& request)
         return strHex;
     }
 
-    return blockToJSON(block, ::ChainActive().Tip(), pblockindex, verbosity >= 2, powHash);
+    if (request.stream) {
+        blockToJSON(*request.stream, block, tip, pblockindex, verbosity >= 2, powHash);
+        return NullUniValue;
+    }
+    return blockToJSON(block, tip, pblockindex, verbosity >= 2, powHash);
 }
 
 static UniValue pruneblockchain(const JSONRPCRequest& request)
@@ -1469,6 +1691,18 @@ static void BIP9SoftForkDescPushBack(UniValue& bip9_softforks, const Consensus::
         bip9_softforks.pushKV(VersionBitsDeploymentInfo[id].name, BIP9SoftForkDesc(consensusParams, id));
 }
 
+void SoftForksToJSON(const CBlockIndex* tip, UniValue& softforks, UniValue& bip9_softforks)
+{
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    // sorted by activation block
+    softforks.push_back(SoftForkDesc("bip34", 2, tip, consensusParams));
+    softforks.push_back(SoftForkDesc("bip66", 3, tip, consensusParams));
+    softforks.push_back(SoftForkDesc("bip65", 4, tip, consensusParams));
+    for (int pos = Consensus::DEPLOYMENT_CSV; pos != Consensus::MAX_VERSION_BITS_DEPLOYMENTS; ++pos) {
+        BIP9SoftForkDescPushBack(bip9_softforks, consensusParams, static_cast<Consensus::DeploymentPos>(pos));
+    }
+}
+
 UniValue getblockchaininfo(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() != 0)
@@ -1527,31 +1761,25 @@ UniValue getblockchaininfo(const JSONRPCRequest& request)
                 },
             }.ToString());
 
-    LOCK(cs_main);
+    // Only changes with the tip, so it is served from the status cache without taking cs_main
+    const auto status = GetRPCStatusSnapshot();
 
     std::string strChainName = gArgs.IsArgSet("-devnet") ? gArgs.GetDevNetName() : Params().NetworkIDString();
 
-    const CBlockIndex* tip = ::ChainActive().Tip();
     UniValue obj(UniValue::VOBJ);
     obj.pushKV("chain",                 strChainName);
-    obj.pushKV("blocks",                (int)::ChainActive().Height());
-    obj.pushKV("headers",               pindexBestHeader ? pindexBestHeader->nHeight : -1);
-    obj.pushKV("bestblockhash",         tip->GetBlockHash().GetHex());
-    obj.pushKV("difficulty",            (double)GetDifficulty(tip));
-    obj.pushKV("mediantime",            (int64_t)tip->GetMedianTimePast());
-    obj.pushKV("verificationprogress",  GuessVerificationProgress(Params().TxData(), tip));
-    obj.pushKV("initialblockdownload",  ::ChainstateActive().IsInitialBlockDownload());
-    obj.pushKV("chainwork",             tip->nChainWork.GetHex());
+    obj.pushKV("blocks",                status->blocks);
+    obj.pushKV("headers",               status->headers);
+    obj.pushKV("bestblockhash",         status->best_block_hash.GetHex());
+    obj.pushKV("difficulty",            status->difficulty);
+    obj.pushKV("mediantime",            status->median_time);
+    obj.pushKV("verificationprogress",  GuessVerificationProgress(Params().TxData(), status->tip));
+    obj.pushKV("initialblockdownload",  status->initial_block_download && ::ChainstateActive().IsInitialBlockDownload());
+    obj.pushKV("chainwork",             status->chain_work);
     obj.pushKV("size_on_disk",          CalculateCurrentUsage());
     obj.pushKV("pruned",                fPruneMode);
     if (fPruneMode) {
-        const CBlockIndex* block = tip;
-        CHECK_NONFATAL(block);
-        while (block->pprev && (block->pprev->nStatus & BLOCK_HAVE_DATA)) {
-            block = block->pprev;
-        }
-
-        obj.pushKV("pruneheight",        block->nHeight);
+        obj.pushKV("pruneheight",        status->prune_height);
 
         // if 0, execution bypasses the whole if block.
         bool automatic_pruning = (gArgs.GetArg("-prune", 0) != 1);
@@ -1561,18 +1789,8 @@ UniValue getblockchaininfo(const JSONRPCRequest& request)
         }
     }
 
-    const Consensus::Params& consensusParams = Params().GetConsensus();
-    UniValue softforks(UniValue::VARR);
-    UniValue bip9_softforks(UniValue::VOBJ);
-    // sorted by activation block
-    softforks.push_back(SoftForkDesc("bip34", 2, tip, consensusParams));
-    softforks.push_back(SoftForkDesc("bip66", 3, tip, consensusParams));
-    softforks.push_back(SoftForkDesc("bip65", 4, tip, consensusParams));
-    for (int pos = Consensus::DEPLOYMENT_CSV; pos != Consensus::MAX_VERSION_BITS_DEPLOYMENTS; ++pos) {
-        BIP9SoftForkDescPushBack(bip9_softforks, consensusParams, static_cast<Consensus::DeploymentPos>(pos));
-    }
-    obj.pushKV("softforks",             softforks);
-    obj.pushKV("bip9_softforks", bip9_softforks);
+    obj.pushKV("softforks",             status->softforks);
+    obj.pushKV("bip9_softforks", status->bip9_softforks);
 
     obj.pushKV("warnings", GetWarnings("statusbar"));
     return obj;
@@ -1973,51 +2191,6 @@ static UniValue getchaintxstats(const JSONRPCRequest& request)
     return ret;
 }
 
-template<typename T>
-static T CalculateTruncatedMedian(std::vector<T>& scores)
-{
-    size_t size = scores.size();
-    if (size == 0) {
-        return 0;
-    }
-
-    std::sort(scores.begin(), scores.end());
-    if (size % 2 == 0) {
-        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
-    } else {
-        return scores[size / 2];
-    }
-}
-
-void CalculatePercentilesBySize(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_size)
-{
-    if (scores.empty()) {
-        return;
-    }
-
-    std::sort(scores.begin(), scores.end());
-
-    // 10th, 25th, 50th, 75th, and 90th percentile weight units.
-    const double weights[NUM_GETBLOCKSTATS_PERCENTILES] = {
-        total_size / 10.0, total_size / 4.0, total_size / 2.0, (total_size * 3.0) / 4.0, (total_size * 9.0) / 10.0
-    };
-
-    int64_t next_percentile_index = 0;
-    int64_t cumulative_weight = 0;
-    for (const auto& element : scores) {
-        cumulative_weight += element.second;
-        while (next_percentile_index < NUM_GETBLOCKSTATS_PERCENTILES && cumulative_weight >= weights[next_percentile_index]) {
-            result[next_percentile_index] = element.first;
-            ++next_percentile_index;
-        }
-    }
-
-    // Fill any remaining percentiles with the last value.
-    for (int64_t i = next_percentile_index; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
-        result[i] = scores.back().first;
-    }
-}
-
 template<typename T>
 static inline bool SetHasKeys(const std::set<T>& set) {return false;}
 template<typename T, typename Tk, typename... Args>
@@ -2026,15 +2199,13 @@ static inline bool SetHasKeys(const std::set<T>& set, const Tk& key, const Args&
     return (set.count(key) != 0) || SetHasKeys(set, args...);
 }
 
-// outpoint (needed for the utxo index) + nHeight + fCoinBase
-static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
-
 static UniValue getblockstats(const JSONRPCRequest& request)
 {
     const RPCHelpMan help{"getblockstats",
                 "\nCompute per block statistics for a given window. All amounts are in duffs.\n"
                 "It won't work for some heights with pruning.\n"
-                "It won't work without -txindex for utxo_size_inc, *fee or *feerate stats.\n",
+                "It won't work without -txindex or -blockstatsindex for utxo_size_inc, *fee or *feerate stats.\n"
+                "With -blockstatsindex the stats of indexed blocks are read from the index instead of being computed.\n",
                 {
                     {"hash_or_height", RPCArg::Type::NUM, RPCArg::Optional::NO, "The block hash or height of the target block", "", {"", "string or numeric"}},
                     {"stats", RPCArg::Type::ARR, /* default */ "all values", "Values to plot (see result below)",
@@ -2050,6 +2221,7 @@ static UniValue getblockstats(const JSONRPCRequest& request)
             "  \"avgfeerate\" : xxxxx,      (numeric) Average feerate (in duffs per byte)\n"
             "  \"avgtxsize\" : xxxxx,       (numeric) Average transaction size\n"
             "  \"blockhash\" : xxxxx,       (string) The block hash (to check for potential reorgs)\n"
+            "  \"coinjoin_txs\" : xxxxx,    (numeric) The number of CoinJoin mixing transactions\n"
             "  \"feerate_percentiles\" : [  (array of numeric) Feerates at the 10th, 25th, 50th, 75th, and 90th percentile weight unit (in duffs per byte)\n"
             "      \"10th_percentile_feerate\",      (numeric) The 10th percentile feerate\n"
             "      \"25th_percentile_feerate\",      (numeric) The 25th percentile feerate\n"
@@ -2069,6 +2241,15 @@ static UniValue getblockstats(const JSONRPCRequest& request)
             "  \"minfeerate\" : xxxxx,      (numeric) Minimum feerate (in duffs per byte)\n"
             "  \"mintxsize\" : xxxxx,       (numeric) Minimum transaction size\n"
             "  \"outs\" : xxxxx,            (numeric) The number of outputs\n"
+            "  \"special_txs\" : {          (json object) The number of special transactions by type\n"
+            "      \"proRegTx\" : xxxxx,      (numeric) Masternode registrations\n"
+            "      \"proUpServTx\" : xxxxx,   (numeric) Masternode service updates\n"
+            "      \"proUpRegTx\" : xxxxx,    (numeric) Masternode registrar updates\n"
+            "      \"proUpRevTx\" : xxxxx,    (numeric) Masternode revocations\n"
+            "      \"cbTx\" : xxxxx,          (numeric) Coinbase special transactions\n"
+            "      \"qcTx\" : xxxxx,          (numeric) Quorum commitments\n"
+            "      \"mnhfTx\" : xxxxx,        (numeric) Masternode hard fork signals\n"
+            "  },\n"
             "  \"subsidy\" : xxxxx,         (numeric) The block subsidy\n"
             "  \"time\" : xxxxx,            (numeric) The block time\n"
             "  \"total_out\" : xxxxx,       (numeric) Total amount in all outputs (excluding coinbase and thus reward [ie subsidy + totalfee])\n"
@@ -2093,6 +2274,9 @@ static UniValue getblockstats(const JSONRPCRequest& request)
     if (g_txindex) {
         g_txindex->BlockUntilSyncedToCurrentChain();
     }
+    if (g_blockstatsindex) {
+        g_blockstatsindex->BlockUntilSyncedToCurrentChain();
+    }
 
     LOCK(cs_main);
 
@@ -2133,135 +2317,93 @@ static UniValue getblockstats(const JSONRPCRequest& request)
         }
     }
 
-    const CBlock block = GetBlockChecked(pindex);
-
     const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
-    const bool do_mediantxsize = do_all || stats.count("mediantxsize") != 0;
-    const bool do_medianfee = do_all || stats.count("medianfee") != 0;
-    const bool do_feerate_percentiles = do_all || stats.count("feerate_percentiles") != 0;
-    const bool loop_inputs = do_all || do_medianfee || do_feerate_percentiles ||
-        SetHasKeys(stats, "utxo_size_inc", "totalfee", "avgfee", "avgfeerate", "minfee", "maxfee", "minfeerate", "maxfeerate");
-    const bool loop_outputs = do_all || loop_inputs || stats.count("total_out");
-    const bool do_calculate_size = do_all || do_mediantxsize ||
+    const bool loop_inputs = do_all || SetHasKeys(stats, "medianfee", "feerate_percentiles",
+        "utxo_size_inc", "totalfee", "avgfee", "avgfeerate", "minfee", "maxfee", "minfeerate", "maxfeerate");
+    BlockStatsSelection selection;
+    selection.median_tx_size = do_all || stats.count("mediantxsize") != 0;
+    selection.median_fee = do_all || stats.count("medianfee") != 0;
+    selection.feerate_percentiles = do_all || stats.count("feerate_percentiles") != 0;
+    selection.total_out = do_all || stats.count("total_out") != 0;
+    selection.tx_sizes = do_all || selection.median_tx_size ||
         SetHasKeys(stats, "total_size", "avgtxsize", "mintxsize", "maxtxsize", "avgfeerate", "feerate_percentiles", "minfeerate", "maxfeerate");
 
-    if (loop_inputs && !g_txindex) {
-        throw JSONRPCError(RPC_INVALID_PARAMETER, "One or more of the selected stats requires -txindex enabled");
-    }
-
-    CAmount maxfee = 0;
-    CAmount maxfeerate = 0;
-    CAmount minfee = MAX_MONEY;
-    CAmount minfeerate = MAX_MONEY;
-    CAmount total_out = 0;
-    CAmount totalfee = 0;
-    int64_t inputs = 0;
-    int64_t maxtxsize = 0;
-    int64_t mintxsize = MaxBlockSize();
-    int64_t outputs = 0;
-    int64_t total_size = 0;
-    int64_t utxo_size_inc = 0;
-    std::vector<CAmount> fee_array;
-    std::vector<std::pair<CAmount, int64_t>> feerate_array;
-    std::vector<int64_t> txsize_array;
-
-    for (const auto& tx : block.vtx) {
-        outputs += tx->vout.size();
-
-        CAmount tx_total_out = 0;
-        if (loop_outputs) {
-            for (const CTxOut& out : tx->vout) {
-                tx_total_out += out.nValue;
-                utxo_size_inc += GetSerializeSize(out, SER_NETWORK, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
-            }
-        }
-
-        if (tx->IsCoinBase()) {
-            continue;
-        }
-
-        inputs += tx->vin.size(); // Don't count coinbase's fake input
-        total_out += tx_total_out; // Don't count coinbase reward
-
-        int64_t tx_size = 0;
-        if (do_calculate_size) {
-
-            tx_size = tx->GetTotalSize();
-            if (do_mediantxsize) {
-                txsize_array.push_back(tx_size);
-            }
-            maxtxsize = std::max(maxtxsize, tx_size);
-            mintxsize = std::min(mintxsize, tx_size);
-            total_size += tx_size;
+    BlockStats block_stats;
+    if (!g_blockstatsindex || !g_blockstatsindex->LookupStats(pindex, block_stats)) {
+        if (loop_inputs && !g_txindex) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "One or more of the selected stats requires -txindex enabled, or -blockstatsindex");
         }
 
+        const CBlock block = GetBlockChecked(pindex);
+        BlockPrevoutLookup lookup_prevout;
         if (loop_inputs) {
-            CAmount tx_total_in = 0;
-            for (const CTxIn& in : tx->vin) {
+            lookup_prevout = [&block](size_t n_tx, size_t n_in, CTxOut& prevout) {
+                const COutPoint& outpoint = block.vtx[n_tx]->vin[n_in].prevout;
                 CTransactionRef tx_in;
                 uint256 hashBlock;
-                if (!GetTransaction(in.prevout.hash, tx_in, Params().GetConsensus(), hashBlock)) {
-                    throw JSONRPCError(RPC_INTERNAL_ERROR, std::string("Unexpected internal error (tx index seems corrupt)"));
+                if (!GetTransaction(outpoint.hash, tx_in, Params().GetConsensus(), hashBlock) || outpoint.n >= tx_in->vout.size()) {
+                    return false;
                 }
-
-                CTxOut prevoutput = tx_in->vout[in.prevout.n];
-
-                tx_total_in += prevoutput.nValue;
-                utxo_size_inc -= GetSerializeSize(prevoutput, SER_NETWORK, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
-            }
-
-            CAmount txfee = tx_total_in - tx_total_out;
-            CHECK_NONFATAL(MoneyRange(txfee));
-            if (do_medianfee) {
-                fee_array.push_back(txfee);
-            }
-            maxfee = std::max(maxfee, txfee);
-            minfee = std::min(minfee, txfee);
-            totalfee += txfee;
-
-            CAmount feerate = tx_size ? txfee / tx_size : 0;
-            if (do_feerate_percentiles) {
-                feerate_array.emplace_back(std::make_pair(feerate, tx_size));
-            }
-            maxfeerate = std::max(maxfeerate, feerate);
-            minfeerate = std::min(minfeerate, feerate);
+                prevout = tx_in->vout[outpoint.n];
+                return true;
+            };
+        }
+        if (!ComputeBlockStats(block, lookup_prevout, block_stats, selection)) {
+            throw JSONRPCError(RPC_INTERNAL_ERROR, std::string("Unexpected internal error (tx index seems corrupt)"));
         }
     }
 
-    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES] = { 0 };
-    CalculatePercentilesBySize(feerate_percentiles, feerate_array, total_size);
-
     UniValue feerates_res(UniValue::VARR);
     for (int64_t i = 0; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
-        feerates_res.push_back(feerate_percentiles[i]);
+        feerates_res.push_back(block_stats.feerate_percentiles[i]);
     }
 
+    UniValue special_txs(UniValue::VOBJ);
+    for (const auto& [type, name] : std::vector<std::pair<uint16_t, std::string>>{
+             {TRANSACTION_PROVIDER_REGISTER, "proRegTx"},
+             {TRANSACTION_PROVIDER_UPDATE_SERVICE, "proUpServTx"},
+             {TRANSACTION_PROVIDER_UPDATE_REGISTRAR, "proUpRegTx"},
+             {TRANSACTION_PROVIDER_UPDATE_REVOKE, "proUpRevTx"},
+             {TRANSACTION_COINBASE, "cbTx"},
+             {TRANSACTION_QUORUM_COMMITMENT, "qcTx"},
+             {TRANSACTION_MNHF_SIGNAL, "mnhfTx"},
+         }) {
+        const auto it = block_stats.special_txs.find(type);
+        special_txs.pushKV(name, it == block_stats.special_txs.end() ? 0 : it->second);
+    }
+
+    const int64_t txs = block_stats.txs;
+    const CAmount totalfee = block_stats.total_fee;
+    const int64_t total_size = block_stats.total_size;
+
     UniValue ret_all(UniValue::VOBJ);
-    ret_all.pushKV("avgfee", (block.vtx.size() > 1) ? totalfee / (block.vtx.size() - 1) : 0);
+    ret_all.pushKV("avgfee", (txs > 1) ? totalfee / (txs - 1) : 0);
     ret_all.pushKV("avgfeerate", total_size ? totalfee / total_size : 0); // Unit: sat/byte
-    ret_all.pushKV("avgtxsize", (block.vtx.size() > 1) ? total_size / (block.vtx.size() - 1) : 0);
+    ret_all.pushKV("avgtxsize", (txs > 1) ? total_size / (txs - 1) : 0);
     ret_all.pushKV("blockhash", pindex->GetBlockHash().GetHex());
+    ret_all.pushKV("coinjoin_txs", block_stats.coinjoin_txs);
     ret_all.pushKV("feerate_percentiles", feerates_res);
     ret_all.pushKV("height", (int64_t)pindex->nHeight);
-    ret_all.pushKV("ins", inputs);
-    ret_all.pushKV("maxfee", maxfee);
-    ret_all.pushKV("maxfeerate", maxfeerate);
-    ret_all.pushKV("maxtxsize", maxtxsize);
-    ret_all.pushKV("medianfee", CalculateTruncatedMedian(fee_array));
+    ret_all.pushKV("ins", block_stats.ins);
+    ret_all.pushKV("maxfee", block_stats.max_fee);
+    ret_all.pushKV("maxfeerate", block_stats.max_feerate);
+    ret_all.pushKV("maxtxsize", block_stats.max_tx_size);
+    ret_all.pushKV("medianfee", block_stats.median_fee);
     ret_all.pushKV("mediantime", pindex->GetMedianTimePast());
-    ret_all.pushKV("mediantxsize", CalculateTruncatedMedian(txsize_array));
-    ret_all.pushKV("minfee", (minfee == MAX_MONEY) ? 0 : minfee);
-    ret_all.pushKV("minfeerate", (minfeerate == MAX_MONEY) ? 0 : minfeerate);
-    ret_all.pushKV("mintxsize", mintxsize == MaxBlockSize() ? 0 : mintxsize);
-    ret_all.pushKV("outs", outputs);
+    ret_all.pushKV("mediantxsize", block_stats.median_tx_size);
+    ret_all.pushKV("minfee", block_stats.min_fee);
+    ret_all.pushKV("minfeerate", block_stats.min_feerate);
+    ret_all.pushKV("mintxsize", block_stats.min_tx_size);
+    ret_all.pushKV("outs", block_stats.outs);
+    ret_all.pushKV("special_txs", special_txs);
     ret_all.pushKV("subsidy", pindex->pprev ? GetBlockSubsidy(pindex->pprev->nBits, pindex->pprev->nHeight, Params().GetConsensus()) : 50 * COIN);
     ret_all.pushKV("time", pindex->GetBlockTime());
-    ret_all.pushKV("total_out", total_out);
+    ret_all.pushKV("total_out", block_stats.total_out);
     ret_all.pushKV("total_size", total_size);
     ret_all.pushKV("totalfee", totalfee);
-    ret_all.pushKV("txs", (int64_t)block.vtx.size());
-    ret_all.pushKV("utxo_increase", outputs - inputs);
-    ret_all.pushKV("utxo_size_inc", utxo_size_inc);
+    ret_all.pushKV("txs", txs);
+    ret_all.pushKV("utxo_increase", block_stats.outs - block_stats.ins);
+    ret_all.pushKV("utxo_size_inc", block_stats.utxo_size_inc);
 
     if (do_all) {
         return ret_all;
@@ -2735,27 +2877,28 @@ static UniValue getblockfilter(const JSONRPCRequest& request)
 static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
-    { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      {} },
-    { "blockchain",         "getchaintxstats",        &getchaintxstats,        {"nblocks", "blockhash"} },
-    { "blockchain",         "getblockstats",          &getblockstats,          {"hash_or_height", "stats"} },
-    { "blockchain",         "getbestblockhash",       &getbestblockhash,       {} },
-    { "blockchain",         "getbestchainlock",       &getbestchainlock,       {} },
-    { "blockchain",         "getblockcount",          &getblockcount,          {} },
-    { "blockchain",         "getblock",               &getblock,               {"blockhash","verbosity|verbose"} },
-    { "blockchain",         "getblockhashes",         &getblockhashes,         {"high","low"} },
-    { "blockchain",         "getblockhash",           &getblockhash,           {"height"} },
-    { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"} },
-    { "blockchain",         "getblockheaders",        &getblockheaders,        {"blockhash","count","verbose"} },
-    { "blockchain",         "getmerkleblocks",        &getmerkleblocks,        {"filter","blockhash","count"} },
-    { "blockchain",         "getchaintips",           &getchaintips,           {"count","branchlen"} },
-    { "blockchain",         "getdifficulty",          &getdifficulty,          {} },
-    { "blockchain",         "getmempoolancestors",    &getmempoolancestors,    {"txid","verbose"} },
-    { "blockchain",         "getmempooldescendants",  &getmempooldescendants,  {"txid","verbose"} },
-    { "blockchain",         "getmempoolentry",        &getmempoolentry,        {"txid"} },
-    { "blockchain",         "getmempoolinfo",         &getmempoolinfo,         {} },
-    { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"} },
-    { "blockchain",         "getspecialtxes",         &getspecialtxes,         {"blockhash", "type", "count", "skip", "verbosity"} },
-    { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"} },
+    { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      {}, /* exclusive */ false },
+    { "blockchain",         "getchaintxstats",        &getchaintxstats,        {"nblocks", "blockhash"}, /* exclusive */ false },
+    { "blockchain",         "getblockstats",          &getblockstats,          {"hash_or_height", "stats"}, /* exclusive */ false },
+    { "blockchain",         "getbestblockhash",       &getbestblockhash,       {}, /* exclusive */ false },
+    { "blockchain",         "getbestchainlock",       &getbestchainlock,       {}, /* exclusive */ false },
+    { "blockchain",         "getchainlockstats",      &getchainlockstats,      {}, /* exclusive */ false },
+    { "blockchain",         "getblockcount",          &getblockcount,          {}, /* exclusive */ false },
+    { "blockchain",         "getblock",               &getblock,               {"blockhash","verbosity|verbose"}, /* exclusive */ false },
+    { "blockchain",         "getblockhashes",         &getblockhashes,         {"high","low"}, /* exclusive */ false },
+    { "blockchain",         "getblockhash",           &getblockhash,           {"height"}, /* exclusive */ false },
+    { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"}, /* exclusive */ false },
+    { "blockchain",         "getblockheaders",        &getblockheaders,        {"blockhash","count","verbose"}, /* exclusive */ false },
+    { "blockchain",         "getmerkleblocks",        &getmerkleblocks,        {"filter","blockhash","count"}, /* exclusive */ false },
+    { "blockchain",         "getchaintips",           &getchaintips,           {"count","branchlen"}, /* exclusive */ false },
+    { "blockchain",         "getdifficulty",          &getdifficulty,          {}, /* exclusive */ false },
+    { "blockchain",         "getmempoolancestors",    &getmempoolancestors,    {"txid","verbose"}, /* exclusive */ false },
+    { "blockchain",         "getmempooldescendants",  &getmempooldescendants,  {"txid","verbose"}, /* exclusive */ false },
+    { "blockchain",         "getmempoolentry",        &getmempoolentry,        {"txid"}, /* exclusive */ false },
+    { "blockchain",         "getmempoolinfo",         &getmempoolinfo,         {}, /* exclusive */ false },
+    { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"}, /* exclusive */ false },
+    { "blockchain",         "getspecialtxes",         &getspecialtxes,         {"blockhash", "type", "count", "skip", "verbosity"}, /* exclusive */ false },
+    { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"}, /* exclusive */ false },
     { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {} },
     { "blockchain",         "pruneblockchain",        &pruneblockchain,        {"height"} },
     { "blockchain",         "savemempool",            &savemempool,            {} },
@@ -2763,7 +2906,7 @@ static const CRPCCommand commands[] =
 
     { "blockchain",         "preciousblock",          &preciousblock,          {"blockhash"} },
     { "blockchain",         "scantxoutset",           &scantxoutset,           {"action", "scanobjects"} },
-    { "blockchain",         "getblockfilter",         &getblockfilter,         {"blockhash", "filtertype"} },
+    { "blockchain",         "getblockfilter",         &getblockfilter,         {"blockhash", "filtertype"}, /* exclusive */ false },
 
     /* Not shown in help */
     { "hidden",             "invalidateblock",        &invalidateblock,        {"blockhash"} },
@@ -759,7 +759,8 @@ static UniValue ListObjects(const std::string& strCachedSignal, const std::strin
         bObj.pushKV("fCachedDelete",  govObj.IsSetCachedDelete());
         bObj.pushKV("fCachedEndorsed",  govObj.IsSetCachedEndorsed());
 
-        objResult.pushKV(govObj.GetHash().ToString(), bObj);
+        // Governance objects have unique hashes, so skip the O(N) duplicate key check of UniValue::pushKV
+        objResult.__pushKV(govObj.GetHash().ToString(), bObj);
     }
 
     return objResult;
@@ -0,0 +1,99 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+
+#include <cassert>
+
+JSONStreamWriter::JSONStreamWriter(Sink sink, size_t flush_size) :
+    m_sink(std::move(sink)),
+    m_flush_size(flush_size)
+{
+    m_buffer.reserve(m_flush_size);
+}
+
+void JSONStreamWriter::BeginValue()
+{
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (!m_empty.empty()) {
+        if (!m_empty.back()) {
+            m_buffer += ',';
+        }
+        m_empty.back() = false;
+    }
+}
+
+void JSONStreamWriter::Write(const std::string& str)
+{
+    m_buffer += str;
+    if (m_buffer.size() >= m_flush_size) {
+        Flush();
+    }
+}
+
+void JSONStreamWriter::BeginObject()
+{
+    BeginValue();
+    m_empty.push_back(true);
+    Write("{");
+}
+
+void JSONStreamWriter::EndObject()
+{
+    assert(!m_empty.empty() && !m_after_key);
+    m_empty.pop_back();
+    Write("}");
+}
+
+void JSONStreamWriter::BeginArray()
+{
+    BeginValue();
+    m_empty.push_back(true);
+    Write("[");
+}
+
+void JSONStreamWriter::EndArray()
+{
+    assert(!m_empty.empty() && !m_after_key);
+    m_empty.pop_back();
+    Write("]");
+}
+
+void JSONStreamWriter::Key(const std::string& key)
+{
+    assert(!m_empty.empty() && !m_after_key);
+    BeginValue();
+    // Let UniValue take care of escaping
+    Write(UniValue(key).write() + ":");
+    m_after_key = true;
+}
+
+void JSONStreamWriter::Value(const UniValue& val)
+{
+    BeginValue();
+    Write(val.write());
+}
+
+void JSONStreamWriter::KeyValues(const UniValue& obj)
+{
+    assert(obj.isObject());
+    const std::vector<std::string>& keys = obj.getKeys();
+    const std::vector<UniValue>& values = obj.getValues();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        KeyValue(keys[i], values[i]);
+    }
+}
+
+void JSONStreamWriter::Flush()
+{
+    if (m_buffer.empty()) {
+        return;
+    }
+    m_written += m_buffer.size();
+    m_sink(m_buffer);
+    m_buffer.clear();
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_RPC_JSONSTREAM_H
+#define BITCOIN_RPC_JSONSTREAM_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <univalue.h>
+
+/**
+ * Incremental JSON emitter for large RPC and REST replies.
+ *
+ * Instead of building the whole reply as one UniValue tree and serializing it
+ * at once, callers write the outer structure (objects and arrays) element by
+ * element. Small values are still built as UniValue and serialized one at a
+ * time. Output is collected into a buffer which is handed to the sink every
+ * time it grows beyond the flush size, so a reply never materializes in memory
+ * as a single string.
+ *
+ * The produced JSON is identical to UniValue::write() without indentation.
+ */
+class JSONStreamWriter
+{
+public:
+    using Sink = std::function<void(const std::string&)>;
+
+    static constexpr size_t DEFAULT_FLUSH_SIZE = 64 * 1024;
+
+    explicit JSONStreamWriter(Sink sink, size_t flush_size = DEFAULT_FLUSH_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    /** Write the key of the next value of the current object */
+    void Key(const std::string& key);
+    /** Write a complete value, either as an array element or after Key() */
+    void Value(const UniValue& val);
+    void KeyValue(const std::string& key, const UniValue& val) { Key(key); Value(val); }
+    /** Write all key/value pairs of obj into the current object */
+    void KeyValues(const UniValue& obj);
+
+    /** Hand all buffered output to the sink */
+    void Flush();
+
+    /** Whether anything was written yet, i.e. whether the writer was used for the reply */
+    bool Used() const { return m_written > 0 || !m_buffer.empty(); }
+    /** Total number of bytes produced so far */
+    size_t GetBytesWritten() const { return m_written + m_buffer.size(); }
+
+private:
+    void BeginValue();
+    void Write(const std::string& str);
+
+    Sink m_sink;
+    const size_t m_flush_size;
+    std::string m_buffer;
+    size_t m_written{0};
+    /** For each open object or array, whether it is still empty */
+    std::vector<bool> m_empty;
+    /** Whether a key was written and its value is pending */
+    bool m_after_key{false};
+};
+
+#endif // BITCOIN_RPC_JSONSTREAM_H
@@ -11,6 +11,7 @@
 #include <net.h>
 #include <netbase.h>
 #include <rpc/server.h>
+#include <rpc/statuscache.h>
 #include <rpc/util.h>
 #include <univalue.h>
 #include <validation.h>
@@ -113,13 +114,11 @@ static UniValue masternode_count(const JSONRPCRequest& request)
     if (request.fHelp || request.params.size() > 1)
         masternode_count_help(request);
 
-    auto mnList = deterministicMNManager->GetListAtChainTip();
-    int total = mnList.GetAllMNsCount();
-    int enabled = mnList.GetValidMNsCount();
+    const auto status = GetRPCStatusSnapshot();
 
     UniValue obj(UniValue::VOBJ);
-    obj.pushKV("total", total);
-    obj.pushKV("enabled", enabled);
+    obj.pushKV("total", (int)status->masternodes_total);
+    obj.pushKV("enabled", (int)status->masternodes_enabled);
     return obj;
 }
 
@@ -588,6 +587,8 @@ static UniValue masternodelist(const JSONRPCRequest& request)
         masternode_list_help(request);
     }
 
+    // Collateral outpoints are unique in the list, so UniValue::__pushKV is used below
+    // instead of UniValue::pushKV, which checks if the key already exists in O(N).
     UniValue obj(UniValue::VOBJ);
 
     auto mnList = deterministicMNManager->GetListAtChainTip();
@@ -632,7 +633,7 @@ static UniValue masternodelist(const JSONRPCRequest& request)
             std::string strAddress = dmn.pdmnState->addr.ToString(false);
             if (strFilter !="" && strAddress.find(strFilter) == std::string::npos &&
                 strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strAddress);
+            obj.__pushKV(strOutpoint, strAddress);
         } else if (strMode == "full") {
             std::ostringstream streamFull;
             streamFull << std::setw(18) <<
@@ -645,7 +646,7 @@ static UniValue masternodelist(const JSONRPCRequest& request)
             std::string strFull = streamFull.str();
             if (strFilter !="" && strFull.find(strFilter) == std::string::npos &&
                 strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strFull);
+            obj.__pushKV(strOutpoint, strFull);
         } else if (strMode == "info") {
             std::ostringstream streamInfo;
             streamInfo << std::setw(18) <<
@@ -656,7 +657,7 @@ static UniValue masternodelist(const JSONRPCRequest& request)
             std::string strInfo = streamInfo.str();
             if (strFilter !="" && strInfo.find(strFilter) == std::string::npos &&
                 strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strInfo);
+            obj.__pushKV(strOutpoint, strInfo);
         } else if (strMode == "json") {
             std::ostringstream streamInfo;
             streamInfo <<  dmn.proTxHash.ToString() << " " <<
@@ -685,31 +686,31 @@ static UniValue masternodelist(const JSONRPCRequest& request)
             objMN.pushKV("votingaddress", EncodeDestination(dmn.pdmnState->keyIDVoting));
             objMN.pushKV("collateraladdress", collateralAddressStr);
             objMN.pushKV("pubkeyoperator", dmn.pdmnState->pubKeyOperator.Get().ToString());
-            obj.pushKV(strOutpoint, objMN);
+            obj.__pushKV(strOutpoint, objMN);
         } else if (strMode == "lastpaidblock") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
+            obj.__pushKV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
         } else if (strMode == "lastpaidtime") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmnToLastPaidTime(dmn));
+            obj.__pushKV(strOutpoint, dmnToLastPaidTime(dmn));
         } else if (strMode == "payee") {
             if (strFilter !="" && payeeStr.find(strFilter) == std::string::npos &&
                 strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, payeeStr);
+            obj.__pushKV(strOutpoint, payeeStr);
         } else if (strMode == "owneraddress") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDOwner));
+            obj.__pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDOwner));
         } else if (strMode == "pubkeyoperator") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmn.pdmnState->pubKeyOperator.Get().ToString());
+            obj.__pushKV(strOutpoint, dmn.pdmnState->pubKeyOperator.Get().ToString());
         } else if (strMode == "status") {
             std::string strStatus = dmnToStatus(dmn);
             if (strFilter !="" && strStatus.find(strFilter) == std::string::npos &&
                 strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strStatus);
+            obj.__pushKV(strOutpoint, strStatus);
         } else if (strMode == "votingaddress") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDVoting));
+            obj.__pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDVoting));
         }
     });
 
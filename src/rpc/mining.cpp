@@ -19,6 +19,7 @@
 #include <rpc/blockchain.h>
 #include <rpc/mining.h>
 #include <rpc/server.h>
+#include <rpc/statuscache.h>
 #include <rpc/util.h>
 #include <shutdown.h>
 #include <txmempool.h>
@@ -43,7 +44,7 @@
  * or from the last difficulty change if 'lookup' is nonpositive.
  * If 'height' is nonnegative, compute the estimate at the time when a given block was found.
  */
-static UniValue GetNetworkHashPS(int lookup, int height) {
+UniValue GetNetworkHashPS(int lookup, int height) {
     CBlockIndex *pb = ::ChainActive().Tip();
 
     if (height >= 0 && height < ::ChainActive().Height())
@@ -224,14 +225,16 @@ static UniValue getmininginfo(const JSONRPCRequest& request)
             }.ToString());
     }
 
-    LOCK(cs_main);
+    const auto status = GetRPCStatusSnapshot();
+    const int64_t last_block_size = BlockAssembler::m_last_block_size;
+    const int64_t last_block_num_txs = BlockAssembler::m_last_block_num_txs;
 
     UniValue obj(UniValue::VOBJ);
-    obj.pushKV("blocks",           (int)::ChainActive().Height());
-    if (BlockAssembler::m_last_block_size) obj.pushKV("currentblocksize", *BlockAssembler::m_last_block_size);
-    if (BlockAssembler::m_last_block_num_txs) obj.pushKV("currentblocktx", *BlockAssembler::m_last_block_num_txs);
-    obj.pushKV("difficulty",       (double)GetDifficulty(::ChainActive().Tip()));
-    obj.pushKV("networkhashps",    getnetworkhashps(request));
+    obj.pushKV("blocks",           status->blocks);
+    if (last_block_size >= 0) obj.pushKV("currentblocksize", last_block_size);
+    if (last_block_num_txs >= 0) obj.pushKV("currentblocktx", last_block_num_txs);
+    obj.pushKV("difficulty",       status->difficulty);
+    obj.pushKV("networkhashps",    status->network_hashps);
     obj.pushKV("pooledtx",         (uint64_t)mempool.size());
     obj.pushKV("chain",            Params().NetworkIDString());
     obj.pushKV("warnings",         GetWarnings("statusbar"));
@@ -11,6 +11,8 @@
 
 static const bool DEFAULT_GENERATE = false;
 static const int DEFAULT_GENERATE_THREADS = 1;
+/** Estimate of the network hashes per second over the last lookup blocks before height, see getnetworkhashps. Requires cs_main. */
+UniValue GetNetworkHashPS(int lookup, int height);
 /** Generate blocks (mine) */
 UniValue generateBlocks(std::shared_ptr<CReserveScript> coinbaseScript, int nGenerate, uint64_t nMaxTries, bool keepScript);
 
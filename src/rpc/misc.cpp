@@ -11,6 +11,7 @@
 #include <key_io.h>
 #include <net.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <script/descriptor.h>
@@ -779,6 +780,7 @@ static UniValue getaddressutxos(const JSONRPCRequest& request)
     std::sort(unspentOutputs.begin(), unspentOutputs.end(), heightSort);
 
     UniValue result(UniValue::VARR);
+    if (request.stream) request.stream->BeginArray();
 
     for (std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >::const_iterator it=unspentOutputs.begin(); it!=unspentOutputs.end(); it++) {
         UniValue output(UniValue::VOBJ);
@@ -793,9 +795,14 @@ static UniValue getaddressutxos(const JSONRPCRequest& request)
         output.pushKV("script", HexStr(it->second.script));
         output.pushKV("satoshis", it->second.satoshis);
         output.pushKV("height", it->second.blockHeight);
-        result.push_back(output);
+        if (request.stream) {
+            request.stream->Value(output);
+        } else {
+            result.push_back(output);
+        }
     }
 
+    if (request.stream) request.stream->EndArray();
     return result;
 }
 
@@ -866,6 +873,7 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
     }
 
     UniValue result(UniValue::VARR);
+    if (request.stream) request.stream->BeginArray();
 
     for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=addressIndex.begin(); it!=addressIndex.end(); it++) {
         std::string address;
@@ -880,9 +888,14 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
         delta.pushKV("blockindex", (int)it->first.txindex);
         delta.pushKV("height", it->first.blockHeight);
         delta.pushKV("address", address);
-        result.push_back(delta);
+        if (request.stream) {
+            request.stream->Value(delta);
+        } else {
+            result.push_back(delta);
+        }
     }
 
+    if (request.stream) request.stream->EndArray();
     return result;
 }
 
@@ -1301,14 +1314,14 @@ static const CRPCCommand commands[] =
     { "util",               "getdescriptorinfo",      &getdescriptorinfo,      {"descriptor"} },
     { "util",               "verifymessage",          &verifymessage,          {"address","signature","message"} },
     { "util",               "signmessagewithprivkey", &signmessagewithprivkey, {"privkey","message"} },
-    { "blockchain",         "getspentinfo",           &getspentinfo,           {"json"} },
+    { "blockchain",         "getspentinfo",           &getspentinfo,           {"json"}, /* exclusive */ false },
 
     /* Address index */
-    { "addressindex",       "getaddressmempool",      &getaddressmempool,      {"addresses"}  },
-    { "addressindex",       "getaddressutxos",        &getaddressutxos,        {"addresses"} },
-    { "addressindex",       "getaddressdeltas",       &getaddressdeltas,       {"addresses"} },
-    { "addressindex",       "getaddresstxids",        &getaddresstxids,        {"addresses"} },
-    { "addressindex",       "getaddressbalance",      &getaddressbalance,      {"addresses"} },
+    { "addressindex",       "getaddressmempool",      &getaddressmempool,      {"addresses"}, /* exclusive */ false },
+    { "addressindex",       "getaddressutxos",        &getaddressutxos,        {"addresses"}, /* exclusive */ false },
+    { "addressindex",       "getaddressdeltas",       &getaddressdeltas,       {"addresses"}, /* exclusive */ false },
+    { "addressindex",       "getaddresstxids",        &getaddresstxids,        {"addresses"}, /* exclusive */ false },
+    { "addressindex",       "getaddressbalance",      &getaddressbalance,      {"addresses"}, /* exclusive */ false },
 
     /* SPRINGBOK features */
     { "springbok",               "mnsync",                 &mnsync,                 {} },
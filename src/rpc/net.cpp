@@ -521,7 +521,14 @@ static UniValue getnetworkinfo(const JSONRPCRequest& request)
             "    \"score\" : xxx                         (numeric) relative score\n"
             "  }\n"
             "  ,...\n"
-            "  ]\n"
+            "  ],\n"
+            "  \"blockcache\" : {                       (json object) blocks and compact blocks kept serialized for sending to peers\n"
+            "    \"entries\" : xxx,                      (numeric) number of cached blocks and compact blocks\n"
+            "    \"bytes\" : xxx,                        (numeric) size of the cached blocks and compact blocks in bytes\n"
+            "    \"maxbytes\" : xxx,                     (numeric) maximum size of the cache in bytes\n"
+            "    \"hits\" : xxx,                         (numeric) number of blocks sent from the cache\n"
+            "    \"misses\" : xxx                        (numeric) number of blocks that had to be serialized\n"
+            "  },\n"
             "  \"warnings\" : \"...\"                    (string) any network and blockchain warnings\n"
             "}\n"
                 },
@@ -587,6 +594,14 @@ static UniValue getnetworkinfo(const JSONRPCRequest& request)
         }
     }
     obj.pushKV("localaddresses", localAddresses);
+    const CSerializedBlockCacheStats blockCacheStats = GetSerializedBlockCacheStats();
+    UniValue blockCache(UniValue::VOBJ);
+    blockCache.pushKV("entries", (uint64_t)blockCacheStats.nEntries);
+    blockCache.pushKV("bytes", (uint64_t)blockCacheStats.nBytes);
+    blockCache.pushKV("maxbytes", (uint64_t)blockCacheStats.nMaxBytes);
+    blockCache.pushKV("hits", blockCacheStats.nHits);
+    blockCache.pushKV("misses", blockCacheStats.nMisses);
+    obj.pushKV("blockcache", blockCache);
     obj.pushKV("warnings",       GetWarnings("statusbar"));
     return obj;
 }
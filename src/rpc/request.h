@@ -10,6 +10,8 @@
 
 #include <univalue.h>
 
+class JSONStreamWriter;
+
 UniValue JSONRPCRequestObj(const std::string& strMethod, const UniValue& params, const UniValue& id);
 UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
 std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
@@ -34,6 +36,12 @@ public:
     std::string URI;
     std::string authUser;
     std::string peerAddr;
+    /**
+     * If set, handlers with large results may write their result into this
+     * writer incrementally and return NullUniValue instead of building it.
+     * Only set for single requests served over HTTP.
+     */
+    JSONStreamWriter* stream{nullptr};
 
     JSONRPCRequest() : id(NullUniValue), params(NullUniValue), fHelp(false) {}
     void parse(const UniValue& valRequest);
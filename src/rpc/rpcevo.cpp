@@ -1162,14 +1162,14 @@ static UniValue protx_diff(const JSONRPCRequest& request)
     uint256 baseBlockHash = ParseBlock(request.params[1], "baseBlock");
     uint256 blockHash = ParseBlock(request.params[2], "block");
 
-    CSimplifiedMNListDiff mnListDiff;
+    std::shared_ptr<const CSimplifiedMNListDiff> mnListDiff;
     std::string strError;
     if (!BuildSimplifiedMNListDiff(baseBlockHash, blockHash, mnListDiff, strError)) {
         throw std::runtime_error(strError);
     }
 
     UniValue ret;
-    mnListDiff.ToJson(ret);
+    mnListDiff->ToJson(ret);
     return ret;
 }
 
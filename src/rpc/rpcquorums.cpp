@@ -691,6 +691,58 @@ static UniValue quorum_rotationinfo(const JSONRPCRequest& request)
     return ret;
 }
 
+static void quorum_sigsharesstats_help(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"quorum sigsharesstats",
+        "Return statistics and estimated memory usage of the signature share state.\n",
+        {},
+        RPCResult{
+            "{\n"
+            "  \"sessions\" : n,                   (numeric) Number of signing sessions known to any peer\n"
+            "  \"sigShares\" : n,                  (numeric) Number of verified signature shares\n"
+            "  \"nodeStates\" : n,                 (numeric) Number of peers with signing state\n"
+            "  \"nodeSessions\" : n,               (numeric) Number of signing sessions summed up over all peers\n"
+            "  \"pendingIncomingSigShares\" : n,   (numeric) Number of received signature shares waiting for verification\n"
+            "  \"requestedSigShares\" : n,         (numeric) Number of signature shares requested from peers\n"
+            "  \"memoryUsage\" : {                 (json object) Estimated dynamic memory usage in bytes\n"
+            "    \"sigShares\" : n,\n"
+            "    \"nodeStates\" : n,\n"
+            "    \"sessions\" : n,\n"
+            "    \"total\" : n\n"
+            "  }\n"
+            "}\n"
+        },
+        RPCExamples{
+            HelpExampleCli("quorum", "sigsharesstats")
+        },
+    }.Check(request);
+}
+
+static UniValue quorum_sigsharesstats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || (request.params.size() != 1)) {
+        quorum_sigsharesstats_help(request);
+    }
+
+    const llmq::CSigSharesStats stats = llmq::quorumSigSharesManager->GetStats();
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("sessions", (uint64_t)stats.nSessions);
+    ret.pushKV("sigShares", (uint64_t)stats.nSigShares);
+    ret.pushKV("nodeStates", (uint64_t)stats.nNodeStates);
+    ret.pushKV("nodeSessions", (uint64_t)stats.nNodeSessions);
+    ret.pushKV("pendingIncomingSigShares", (uint64_t)stats.nPendingIncomingSigShares);
+    ret.pushKV("requestedSigShares", (uint64_t)stats.nRequestedSigShares);
+
+    UniValue usage(UniValue::VOBJ);
+    usage.pushKV("sigShares", (uint64_t)stats.nSigSharesUsage);
+    usage.pushKV("nodeStates", (uint64_t)stats.nNodeStatesUsage);
+    usage.pushKV("sessions", (uint64_t)stats.nSessionsUsage);
+    usage.pushKV("total", (uint64_t)(stats.nSigSharesUsage + stats.nNodeStatesUsage + stats.nSessionsUsage));
+    ret.pushKV("memoryUsage", usage);
+
+    return ret;
+}
 
 [[ noreturn ]] static void quorum_help()
 {
@@ -712,7 +764,8 @@ static UniValue quorum_rotationinfo(const JSONRPCRequest& request)
             "  isconflicting     - Test if a conflict exists\n"
             "  selectquorum      - Return the quorum that would/should sign a request\n"
             "  getdata           - Request quorum data from other masternodes in the quorum\n"
-            "  rotationinfo      - Request quorum rotation information\n",
+            "  rotationinfo      - Request quorum rotation information\n"
+            "  sigsharesstats    - Return statistics and memory usage of the signature share state\n",
             {
                 {"command", RPCArg::Type::STR, RPCArg::Optional::NO, "The command to execute"},
             },
@@ -751,6 +804,8 @@ static UniValue _quorum(const JSONRPCRequest& request)
         return quorum_getdata(request);
     } else if (command == "rotationinfo") {
         return quorum_rotationinfo(request);
+    } else if (command == "sigsharesstats") {
+        return quorum_sigsharesstats(request);
     } else {
         quorum_help();
     }
@@ -7,17 +7,23 @@
 #include <rpc/server.h>
 
 #include <chainparams.h>
+#include <httpserver.h>
 #include <rpc/util.h>
 #include <shutdown.h>
+#include <statsd_client.h>
 #include <sync.h>
 #include <util/strencodings.h>
 #include <util/system.h>
 
+#include <ctpl_stl.h>
+
 #include <boost/signals2/signal.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
 #include <algorithm>
+#include <array>
+#include <map>
 #include <memory> // for unique_ptr
 #include <unordered_map>
 
@@ -29,6 +35,9 @@ static std::string rpcWarmupStatus GUARDED_BY(cs_rpcWarmup) = "RPC server starte
 static RPCTimerInterface* timerInterface = nullptr;
 /* Map of name to timer. */
 static std::map<std::string, std::unique_ptr<RPCTimerBase> > deadlineTimers;
+/* Threads executing the calls of JSON-RPC batches and other RPC work in parallel, see RPCParallelFor */
+static Mutex g_batch_pool_mutex;
+static std::shared_ptr<ctpl::thread_pool> g_batch_pool GUARDED_BY(g_batch_pool_mutex);
 static bool ExecuteCommand(const CRPCCommand& command, const JSONRPCRequest& request, UniValue& result, bool last_handler, std::multimap<std::string, std::vector<UniValue>> mapPlatformRestrictions);
 
 // Any commands submitted by this user will have their commands filtered based on the mapPlatformRestrictions
@@ -40,10 +49,53 @@ struct RPCCommandExecutionInfo
     int64_t start;
 };
 
+/** Number of latency histogram buckets, bucket i counts the calls which took [2^i, 2^(i+1)) microseconds */
+static constexpr size_t RPC_LATENCY_BUCKETS = 36;
+
+/** Statistics of the calls of a method since startup, times in microseconds */
+struct RPCMethodStats
+{
+    uint64_t calls{0};
+    uint64_t errors{0};
+    int64_t total_time{0};
+    int64_t max_time{0};
+    std::array<uint64_t, RPC_LATENCY_BUCKETS> latency{};
+    /** Time spent waiting for contended locks, per lock name */
+    std::map<std::string, int64_t> lock_wait;
+
+    void Add(int64_t duration, bool success, const LockWaitTracker& lock_waits)
+    {
+        calls++;
+        if (!success) errors++;
+        total_time += duration;
+        max_time = std::max(max_time, duration);
+        size_t bucket = 0;
+        while (bucket + 1 < RPC_LATENCY_BUCKETS && (duration >> (bucket + 1)) > 0) bucket++;
+        latency[bucket]++;
+        for (const auto& [name, wait] : lock_waits.GetWaits()) {
+            lock_wait[name] += wait.count();
+        }
+    }
+
+    /** Upper bound of the latency of the given fraction of calls */
+    int64_t Percentile(double fraction) const
+    {
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < RPC_LATENCY_BUCKETS; bucket++) {
+            seen += latency[bucket];
+            if (seen > 0 && seen >= fraction * calls) {
+                return std::min(max_time, (int64_t{2} << bucket) - 1);
+            }
+        }
+        return max_time;
+    }
+};
+
 struct RPCServerInfo
 {
     Mutex mutex;
     std::list<RPCCommandExecutionInfo> active_commands GUARDED_BY(mutex);
+    std::map<std::string, RPCMethodStats> method_stats GUARDED_BY(mutex);
 };
 
 static RPCServerInfo g_rpc_server_info;
@@ -51,6 +103,9 @@ static RPCServerInfo g_rpc_server_info;
 struct RPCCommandExecution
 {
     std::list<RPCCommandExecutionInfo>::iterator it;
+    //! Set once the command completed without throwing
+    bool success{false};
+    LockWaitTracker lock_waits;
     explicit RPCCommandExecution(const std::string& method)
     {
         LOCK(g_rpc_server_info.mutex);
@@ -58,7 +113,18 @@ struct RPCCommandExecution
     }
     ~RPCCommandExecution()
     {
+        const int64_t duration = GetTimeMicros() - it->start;
+        int64_t lock_wait{0};
+        for (const auto& [_, wait] : lock_waits.GetWaits()) {
+            lock_wait += wait.count();
+        }
+
+        statsClient.timing("rpc." + it->method + "_ms", duration / 1000, 1.0f);
+        if (lock_wait > 0) statsClient.timing("rpc." + it->method + ".lockWait_ms", lock_wait / 1000, 1.0f);
+        if (!success) statsClient.inc("rpc." + it->method + ".errors", 1.0f);
+
         LOCK(g_rpc_server_info.mutex);
+        g_rpc_server_info.method_stats[it->method].Add(duration, success, lock_waits);
         g_rpc_server_info.active_commands.erase(it);
     }
 };
@@ -265,12 +331,99 @@ static UniValue getrpcinfo(const JSONRPCRequest& request)
     return result;
 }
 
+static UniValue getrpcstats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() > 0) {
+        throw std::runtime_error(
+            RPCHelpMan{"getrpcstats",
+                       "\nReturns statistics of the RPC calls since startup, per method, and of the HTTP work queue.\n"
+                       "All times are in microseconds. Latency percentiles are upper bounds, taken from a histogram with power of 2 buckets.\n",
+                       {},
+                RPCResult{
+            "{\n"
+            " \"work_queue\": {           (object) The queue of HTTP requests waiting for a worker thread\n"
+            "   \"depth\": n,              (numeric) The number of queued requests\n"
+            "   \"max_depth\": n,          (numeric) The maximum number of queued requests (-rpcworkqueue)\n"
+            "   \"rejected\": n            (numeric) The number of requests rejected because the queue was full\n"
+            " },\n"
+            " \"fast_work_queue\": {      (object) The queue of requests for the methods in -rpcfastmethods, same fields as work_queue\n"
+            "   ...\n"
+            " },\n"
+            " \"methods\": {              (object) Statistics per method which was called at least once\n"
+            "   \"method\": {             (object) The name of the RPC command\n"
+            "     \"calls\": n,            (numeric) The number of completed calls\n"
+            "     \"errors\": n,           (numeric) The number of calls which failed\n"
+            "     \"in_flight\": n,        (numeric) The number of calls currently executing\n"
+            "     \"total_time\": n,       (numeric) The total time spent in completed calls\n"
+            "     \"p50\": n,              (numeric) The median latency\n"
+            "     \"p99\": n,              (numeric) The 99th percentile latency\n"
+            "     \"max\": n,              (numeric) The maximum latency\n"
+            "     \"lock_wait\": {         (object) The total time spent waiting for contended locks, per lock\n"
+            "       \"lock\": n,           (numeric) The time spent waiting for this lock, e.g. cs_main\n"
+            "       ...\n"
+            "     }\n"
+            "   },...\n"
+            " }\n"
+            "}\n"
+                },
+                RPCExamples{
+                    HelpExampleCli("getrpcstats", "")
+                + HelpExampleRpc("getrpcstats", "")},
+            }.ToString()
+        );
+    }
+
+    const auto work_queue_to_json = [](HTTPWorkQueueClass queue_class) {
+        const HTTPWorkQueueStats queue_stats = GetHTTPWorkQueueStats(queue_class);
+        UniValue work_queue(UniValue::VOBJ);
+        work_queue.pushKV("depth", (uint64_t)queue_stats.depth);
+        work_queue.pushKV("max_depth", (uint64_t)queue_stats.max_depth);
+        work_queue.pushKV("rejected", queue_stats.rejected);
+        return work_queue;
+    };
+    UniValue work_queue = work_queue_to_json(HTTPWorkQueueClass::DEFAULT);
+    UniValue fast_work_queue = work_queue_to_json(HTTPWorkQueueClass::FAST);
+
+    LOCK(g_rpc_server_info.mutex);
+    std::map<std::string, uint64_t> in_flight;
+    for (const RPCCommandExecutionInfo& info : g_rpc_server_info.active_commands) {
+        in_flight[info.method]++;
+        // Make sure methods show up while their first call is executing
+        g_rpc_server_info.method_stats[info.method];
+    }
+
+    UniValue methods(UniValue::VOBJ);
+    for (const auto& [method, stats] : g_rpc_server_info.method_stats) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("calls", stats.calls);
+        entry.pushKV("errors", stats.errors);
+        entry.pushKV("in_flight", in_flight[method]);
+        entry.pushKV("total_time", stats.total_time);
+        entry.pushKV("p50", stats.Percentile(0.5));
+        entry.pushKV("p99", stats.Percentile(0.99));
+        entry.pushKV("max", stats.max_time);
+        UniValue lock_wait(UniValue::VOBJ);
+        for (const auto& [lock, wait] : stats.lock_wait) {
+            lock_wait.pushKV(lock, wait);
+        }
+        entry.pushKV("lock_wait", lock_wait);
+        methods.pushKV(method, entry);
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("work_queue", work_queue);
+    result.pushKV("fast_work_queue", fast_work_queue);
+    result.pushKV("methods", methods);
+    return result;
+}
+
 // clang-format off
 static const CRPCCommand vRPCCommands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
     /* Overall control/query calls */
     { "control",            "getrpcinfo",             &getrpcinfo,             {}  },
+    { "control",            "getrpcstats",            &getrpcstats,            {}  },
     { "control",            "help",                   &help,                   {"command","subcommand"}  },
     { "control",            "stop",                   &stop,                   {"wait"}  },
     { "control",            "uptime",                 &uptime,                 {}  },
@@ -315,6 +468,13 @@ void StartRPC()
 {
     LogPrint(BCLog::RPC, "Starting RPC\n");
     fRPCRunning = true;
+    int batch_threads = std::max((int)gArgs.GetArg("-rpcbatchthreads", DEFAULT_RPC_BATCH_THREADS), 0);
+    if (batch_threads > 0) {
+        LogPrint(BCLog::RPC, "Starting %d threads for JSON-RPC batches\n", batch_threads);
+        auto pool = std::make_shared<ctpl::thread_pool>(batch_threads);
+        RenameThreadPool(*pool, "rpc-batch");
+        WITH_LOCK(g_batch_pool_mutex, g_batch_pool = pool);
+    }
     g_rpcSignals.Started();
 }
 
@@ -329,6 +489,8 @@ void StopRPC()
 {
     LogPrint(BCLog::RPC, "Stopping RPC\n");
     deadlineTimers.clear();
+    // Batches which are still executing keep the pool alive until they are done
+    WITH_LOCK(g_batch_pool_mutex, g_batch_pool.reset());
     DeleteAuthCookie();
     g_rpcSignals.Stopped();
 }
@@ -389,12 +551,107 @@ static UniValue JSONRPCExecOne(JSONRPCRequest jreq, const UniValue& req)
     return rpc_result;
 }
 
+/**
+ * Work items which are executed in parallel. Threads claim the next item by
+ * incrementing next_item. The state is shared with the helper tasks, as tasks which
+ * only start after all items were claimed may outlive the caller. Such tasks never
+ * dereference fn.
+ */
+struct RPCParallelRun
+{
+    const std::function<void(size_t)>* const fn;
+    const size_t count;
+    std::atomic<size_t> next_item{0};
+    std::atomic<size_t> remaining;
+    Mutex cs;
+    std::condition_variable cond;
+    bool done GUARDED_BY(cs){false};
+    std::exception_ptr error GUARDED_BY(cs);
+
+    RPCParallelRun(const std::function<void(size_t)>& fn, size_t count) : fn(&fn), count(count), remaining(count) {}
+
+    void Run()
+    {
+        for (size_t i = next_item++; i < count; i = next_item++) {
+            try {
+                (*fn)(i);
+            } catch (...) {
+                LOCK(cs);
+                if (!error) error = std::current_exception();
+            }
+            if (--remaining == 0) {
+                LOCK(cs);
+                done = true;
+                cond.notify_all();
+            }
+        }
+    }
+};
+
+static void ParallelFor(ctpl::thread_pool& pool, size_t count, const std::function<void(size_t)>& fn)
+{
+    auto run = std::make_shared<RPCParallelRun>(fn, count);
+    // The calling thread does work as well, so it progresses even if all helpers are busy
+    size_t helpers = std::min<size_t>(pool.size(), count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        pool.push([run](int) { run->Run(); });
+    }
+    run->Run();
+    // Wait for the items claimed by helpers, helpers which did not get to claim any item don't matter
+    WAIT_LOCK(run->cs, lock);
+    run->cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(run->cs) { return run->done; });
+    if (run->error) {
+        std::rethrow_exception(run->error);
+    }
+}
+
+void RPCParallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    std::shared_ptr<ctpl::thread_pool> pool;
+    if (count > 1) {
+        pool = WITH_LOCK(g_batch_pool_mutex, return g_batch_pool);
+    }
+    if (!pool) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    ParallelFor(*pool, count, fn);
+}
+
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq)
 {
-    UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+    std::shared_ptr<ctpl::thread_pool> pool;
+    if (vReq.size() >= RPC_BATCH_PARALLEL_MIN_SIZE) {
+        pool = WITH_LOCK(g_batch_pool_mutex, return g_batch_pool);
+    }
 
+    std::vector<UniValue> results(vReq.size());
+    size_t reqIdx = 0;
+    while (reqIdx < vReq.size()) {
+        // Find the run of non-exclusive calls starting at reqIdx
+        size_t runEnd = reqIdx;
+        if (pool) {
+            while (runEnd < vReq.size() && vReq[runEnd].isObject() && !tableRPC.isExclusive(find_value(vReq[runEnd], "method").getValStr())) {
+                runEnd++;
+            }
+        }
+        if (runEnd - reqIdx > 1) {
+            ParallelFor(*pool, runEnd - reqIdx, [&, begin = reqIdx](size_t i) {
+                results[begin + i] = JSONRPCExecOne(jreq, vReq[begin + i]);
+            });
+            reqIdx = runEnd;
+        } else {
+            results[reqIdx] = JSONRPCExecOne(jreq, vReq[reqIdx]);
+            reqIdx++;
+        }
+    }
+
+    UniValue ret(UniValue::VARR);
+    for (const UniValue& result : results) {
+        ret.push_back(result);
+    }
     return ret.write() + "\n";
 }
 
@@ -537,11 +794,14 @@ static bool ExecuteCommand(const CRPCCommand& command, const JSONRPCRequest& req
     {
         RPCCommandExecution execution(request.strMethod);
         // Execute, convert arguments to array if necessary
+        bool handled;
         if (request.params.isObject()) {
-            return command.actor(transformNamedArguments(request, command.argNames), result, last_handler);
+            handled = command.actor(transformNamedArguments(request, command.argNames), result, last_handler);
         } else {
-            return command.actor(request, result, last_handler);
+            handled = command.actor(request, result, last_handler);
         }
+        execution.success = true;
+        return handled;
     }
     catch (const std::exception& e)
     {
@@ -549,6 +809,15 @@ static bool ExecuteCommand(const CRPCCommand& command, const JSONRPCRequest& req
     }
 }
 
+bool CRPCTable::isExclusive(const std::string& method) const
+{
+    auto it = mapCommands.find(method);
+    if (it == mapCommands.end()) {
+        return false;
+    }
+    return std::any_of(it->second.begin(), it->second.end(), [](const CRPCCommand* pcmd) { return pcmd->exclusive; });
+}
+
 std::vector<std::string> CRPCTable::listCommands() const
 {
     std::vector<std::string> commandList;
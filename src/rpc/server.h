@@ -92,9 +92,9 @@ public:
     using Actor = std::function<bool(const JSONRPCRequest& request, UniValue& result, bool last_handler)>;
 
     //! Constructor taking Actor callback supporting multiple handlers.
-    CRPCCommand(std::string category, std::string name, Actor actor, std::vector<std::string> args, intptr_t unique_id)
+    CRPCCommand(std::string category, std::string name, Actor actor, std::vector<std::string> args, intptr_t unique_id, bool exclusive = true)
         : category(std::move(category)), name(std::move(name)), actor(std::move(actor)), argNames(std::move(args)),
-          unique_id(unique_id)
+          unique_id(unique_id), exclusive(exclusive)
     {
     }
 
@@ -112,10 +112,10 @@ public:
     }
 
     //! Simplified constructor taking plain rpcfn_type function pointer.
-    CRPCCommand(const char* category, const char* name, rpcfn_type fn, std::initializer_list<const char*> args)
+    CRPCCommand(const char* category, const char* name, rpcfn_type fn, std::initializer_list<const char*> args, bool exclusive = true)
         : CRPCCommand(category, name,
                       [fn](const JSONRPCRequest& request, UniValue& result, bool) { result = fn(request); return true; },
-                      {args.begin(), args.end()}, intptr_t(fn))
+                      {args.begin(), args.end()}, intptr_t(fn), exclusive)
     {
     }
 
@@ -124,6 +124,10 @@ public:
     Actor actor;
     std::vector<std::string> argNames;
     intptr_t unique_id;
+    //! Whether the command has to run on its own when it is part of a batch, i.e. after all
+    //! preceding and before all following calls of the batch. Commands which neither change
+    //! any state nor depend on state changed by other calls may run in parallel instead.
+    bool exclusive;
 };
 
 /**
@@ -154,6 +158,12 @@ public:
     */
     std::vector<std::string> listCommands() const;
 
+    /**
+     * Whether a method has to be executed exclusively when it is part of a batch.
+     * Unknown methods are not exclusive, as they only produce an error.
+     */
+    bool isExclusive(const std::string& method) const;
+
     /**
      * Appends a CRPCCommand to the dispatch table.
      *
@@ -174,9 +184,24 @@ bool IsDeprecatedRPCEnabled(const std::string& method);
 
 extern CRPCTable tableRPC;
 
+/** Default number of threads which execute the calls of JSON-RPC batches in parallel */
+static const int DEFAULT_RPC_BATCH_THREADS = 4;
+/** Batches with less calls are always executed sequentially */
+static const size_t RPC_BATCH_PARALLEL_MIN_SIZE = 4;
+
 void StartRPC();
 void InterruptRPC();
 void StopRPC();
+/**
+ * Execute a batch of requests. Consecutive calls of non-exclusive commands are
+ * executed in parallel, the order of the replies is that of the requests.
+ */
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq);
+/**
+ * Call fn for each index in [0, count). The calls are spread over the threads of -rpcbatchthreads
+ * and the calling thread, which also makes this safe to use from a call of a batch. Returns after
+ * all calls finished, rethrowing the first exception thrown by fn.
+ */
+void RPCParallelFor(size_t count, const std::function<void(size_t)>& fn);
 
 #endif // BITCOIN_RPC_SERVER_H
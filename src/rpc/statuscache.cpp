@@ -0,0 +1,100 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/statuscache.h>
+
+#include <evo/deterministicmns.h>
+#include <rpc/blockchain.h>
+#include <rpc/mining.h>
+#include <util/check.h>
+#include <validation.h>
+
+std::unique_ptr<CRPCStatusCache> g_rpc_status_cache;
+
+static std::shared_ptr<const RPCStatusSnapshot> BuildRPCStatusSnapshot() EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    AssertLockHeld(cs_main);
+
+    const CBlockIndex* tip = ::ChainActive().Tip();
+    CHECK_NONFATAL(tip);
+
+    auto snapshot = std::make_shared<RPCStatusSnapshot>();
+    snapshot->tip = tip;
+    snapshot->blocks = tip->nHeight;
+    snapshot->headers = pindexBestHeader ? pindexBestHeader->nHeight : -1;
+    snapshot->best_block_hash = tip->GetBlockHash();
+    snapshot->difficulty = GetDifficulty(tip);
+    snapshot->median_time = tip->GetMedianTimePast();
+    snapshot->chain_work = tip->nChainWork.GetHex();
+    snapshot->initial_block_download = ::ChainstateActive().IsInitialBlockDownload();
+    if (fPruneMode) {
+        const CBlockIndex* block = tip;
+        while (block->pprev && (block->pprev->nStatus & BLOCK_HAVE_DATA)) {
+            block = block->pprev;
+        }
+        snapshot->prune_height = block->nHeight;
+    }
+    SoftForksToJSON(tip, snapshot->softforks, snapshot->bip9_softforks);
+    snapshot->network_hashps = GetNetworkHashPS(120, -1);
+    if (deterministicMNManager) {
+        auto mnList = deterministicMNManager->GetListAtChainTip();
+        snapshot->masternodes_total = mnList.GetAllMNsCount();
+        snapshot->masternodes_enabled = mnList.GetValidMNsCount();
+    }
+    return snapshot;
+}
+
+std::shared_ptr<const RPCStatusSnapshot> CRPCStatusCache::Rebuild()
+{
+    LOCK(cs_main);
+    // Cleared before building, so that changes from now on invalidate the new snapshot again
+    m_dirty = false;
+    auto snapshot = BuildRPCStatusSnapshot();
+    LOCK(m_mutex);
+    m_snapshot = snapshot;
+    return snapshot;
+}
+
+std::shared_ptr<const RPCStatusSnapshot> CRPCStatusCache::Get()
+{
+    if (!m_dirty) {
+        LOCK(m_mutex);
+        if (m_snapshot) {
+            return m_snapshot;
+        }
+    }
+    return Rebuild();
+}
+
+void CRPCStatusCache::SynchronousUpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload)
+{
+    m_dirty = true;
+}
+
+void CRPCStatusCache::UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload)
+{
+    // During initial block download tips change faster than anyone polls, let the readers rebuild on demand
+    if (!fInitialDownload && m_dirty) {
+        Rebuild();
+    }
+}
+
+void CRPCStatusCache::NotifyHeaderTip(const CBlockIndex* pindexNew, bool fInitialDownload)
+{
+    m_dirty = true;
+}
+
+void CRPCStatusCache::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
+{
+    m_dirty = true;
+}
+
+std::shared_ptr<const RPCStatusSnapshot> GetRPCStatusSnapshot()
+{
+    if (g_rpc_status_cache) {
+        return g_rpc_status_cache->Get();
+    }
+    LOCK(cs_main);
+    return BuildRPCStatusSnapshot();
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_RPC_STATUSCACHE_H
+#define BITCOIN_RPC_STATUSCACHE_H
+
+#include <sync.h>
+#include <uint256.h>
+#include <validationinterface.h>
+
+#include <univalue.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+class CBlockIndex;
+
+/** Chain and masternode list state reported by the status RPCs (getblockchaininfo, getmininginfo, masternode count).
+ * Everything in here only changes with the chain tip or the best header.
+ */
+struct RPCStatusSnapshot
+{
+    //! Never freed while the node is running, used for the time dependent verification progress
+    const CBlockIndex* tip{nullptr};
+    int blocks{-1};
+    int headers{-1};
+    uint256 best_block_hash;
+    double difficulty{0};
+    int64_t median_time{0};
+    std::string chain_work;
+    //! Latches to false, so it only needs to be re-checked while true
+    bool initial_block_download{true};
+    //! Lowest height with complete block data, -1 if not pruning
+    int prune_height{-1};
+    UniValue softforks{UniValue::VARR};
+    UniValue bip9_softforks{UniValue::VOBJ};
+    UniValue network_hashps;
+    size_t masternodes_total{0};
+    size_t masternodes_enabled{0};
+};
+
+/** Keeps an RPCStatusSnapshot up to date, so that frequent polling of the status RPCs does not contend with
+ * validation for cs_main. The snapshot is invalidated synchronously on every tip, header and masternode list
+ * change, and rebuilt eagerly on new tips once the initial block download finished. During initial block download
+ * the next reader rebuilds it instead.
+ */
+class CRPCStatusCache : public CValidationInterface
+{
+private:
+    Mutex m_mutex;
+    std::shared_ptr<const RPCStatusSnapshot> m_snapshot GUARDED_BY(m_mutex);
+    std::atomic<bool> m_dirty{true};
+
+    std::shared_ptr<const RPCStatusSnapshot> Rebuild() LOCKS_EXCLUDED(m_mutex);
+
+public:
+    std::shared_ptr<const RPCStatusSnapshot> Get() LOCKS_EXCLUDED(m_mutex);
+    void SetDirty() { m_dirty = true; }
+
+protected:
+    // CValidationInterface
+    void SynchronousUpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload) override;
+    void UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload) override;
+    void NotifyHeaderTip(const CBlockIndex* pindexNew, bool fInitialDownload) override;
+    void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) override;
+};
+
+extern std::unique_ptr<CRPCStatusCache> g_rpc_status_cache;
+
+/** Return the cached status snapshot, or build a fresh one if there is no cache (e.g. in unit tests). */
+std::shared_ptr<const RPCStatusSnapshot> GetRPCStatusSnapshot();
+
+#endif // BITCOIN_RPC_STATUSCACHE_H
@@ -33,10 +33,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <compat.h>
 #include <netbase.h>
 #include <random.h>
+#include <sync.h>
+#include <threadinterrupt.h>
 #include <util/system.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
 
 statsd::StatsdClient statsClient;
 
@@ -61,6 +67,12 @@ inline bool should_send(float sample_rate)
     return sample_rate > p;
 }
 
+static bool IsEnabled()
+{
+    static bool fEnabled = gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE);
+    return fEnabled;
+}
+
 struct _StatsdClientData {
     SOCKET  sock;
     struct  sockaddr_in server;
@@ -72,8 +84,45 @@ struct _StatsdClientData {
     bool    init;
 
     char    errmsg[1024];
+
+    // guards the socket and the configuration above, metrics can be sent from any thread until the flusher is started
+    Mutex   cs_sock;
+
+    Mutex   cs_queue;
+    std::vector<std::string> queue GUARDED_BY(cs_queue);
+    uint64_t nDropped GUARDED_BY(cs_queue){0};
+
+    Mutex   cs_handles;
+    std::vector<Counter*> counters GUARDED_BY(cs_handles);
+    std::vector<Gauge*> gauges GUARDED_BY(cs_handles);
+
+    std::thread threadFlusher;
+    CThreadInterrupt interruptFlusher;
+    std::atomic<bool> fFlusherRunning{false};
 };
 
+Counter::Counter(StatsdClient& client, const std::string& key) :
+    m_client(client), m_key(key)
+{
+    m_client.registerHandle(this);
+}
+
+Counter::~Counter()
+{
+    m_client.unregisterHandle(this);
+}
+
+Gauge::Gauge(StatsdClient& client, const std::string& key) :
+    m_client(client), m_key(key)
+{
+    m_client.registerHandle(this);
+}
+
+Gauge::~Gauge()
+{
+    m_client.unregisterHandle(this);
+}
+
 StatsdClient::StatsdClient(const std::string& host, int port, const std::string& ns) :
     d(std::make_unique<_StatsdClientData>())
 {
@@ -83,6 +132,7 @@ StatsdClient::StatsdClient(const std::string& host, int port, const std::string&
 
 StatsdClient::~StatsdClient()
 {
+    Stop();
     // close socket
     CloseSocket(d->sock);
 }
@@ -98,8 +148,7 @@ void StatsdClient::config(const std::string& host, int port, const std::string&
 
 int StatsdClient::init()
 {
-    static bool fEnabled = gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE);
-    if (!fEnabled) return -3;
+    if (!IsEnabled()) return -3;
 
     if ( d->init ) return 0;
 
@@ -170,68 +219,72 @@ int StatsdClient::timing(const std::string& key, size_t ms, float sample_rate)
     return send(key, ms, "ms", sample_rate);
 }
 
-int StatsdClient::send(std::string key, size_t value, const std::string& type, float sample_rate)
+std::string StatsdClient::format(std::string key, const std::string& value, const std::string& type, float sample_rate)
 {
-    if (!should_send(sample_rate)) {
-        return 0;
-    }
-
     // partition stats by node name if set
     if (!d->nodename.empty())
         key = key + "." + d->nodename;
 
     cleanup(key);
 
-    char buf[256];
     if ( fequal( sample_rate, 1.0 ) )
     {
-        snprintf(buf, sizeof(buf), "%s%s:%zd|%s",
-                d->ns.c_str(), key.c_str(), (ssize_t) value, type.c_str());
+        return strprintf("%s%s:%s|%s", d->ns, key, value, type);
     }
-    else
-    {
-        snprintf(buf, sizeof(buf), "%s%s:%zd|%s|@%.2f",
-                d->ns.c_str(), key.c_str(), (ssize_t) value, type.c_str(), sample_rate);
+    return strprintf("%s%s:%s|%s|@%.2f", d->ns, key, value, type, sample_rate);
+}
+
+int StatsdClient::send(std::string key, size_t value, const std::string& type, float sample_rate)
+{
+    if (!IsEnabled()) {
+        return -3;
+    }
+    if (!should_send(sample_rate)) {
+        return 0;
     }
 
-    return send(buf);
+    return send(format(std::move(key), strprintf("%d", (ssize_t) value), type, sample_rate));
 }
 
 int StatsdClient::sendDouble(std::string key, double value, const std::string& type, float sample_rate)
 {
+    if (!IsEnabled()) {
+        return -3;
+    }
     if (!should_send(sample_rate)) {
         return 0;
     }
 
-    // partition stats by node name if set
-    if (!d->nodename.empty())
-        key = key + "." + d->nodename;
-
-    cleanup(key);
+    return send(format(std::move(key), strprintf("%f", value), type, sample_rate));
+}
 
-    char buf[256];
-    if ( fequal( sample_rate, 1.0 ) )
-    {
-        snprintf(buf, sizeof(buf), "%s%s:%f|%s",
-                d->ns.c_str(), key.c_str(), value, type.c_str());
-    }
-    else
-    {
-        snprintf(buf, sizeof(buf), "%s%s:%f|%s|@%.2f",
-                d->ns.c_str(), key.c_str(), value, type.c_str(), sample_rate);
+int StatsdClient::send(const std::string& message)
+{
+    if (!d->fFlusherRunning) {
+        return sendDatagram(message);
     }
 
-    return send(buf);
+    LOCK(d->cs_queue);
+    if (d->queue.size() >= MAX_STATSD_QUEUE_SIZE) {
+        d->nDropped++;
+        return -1;
+    }
+    d->queue.emplace_back(message);
+    return 0;
 }
 
-int StatsdClient::send(const std::string& message)
+int StatsdClient::sendDatagram(const std::string& datagram)
 {
+    if (!IsEnabled()) {
+        return -3;
+    }
+    LOCK(d->cs_sock);
     int ret = init();
     if ( ret )
     {
         return ret;
     }
-    ret = sendto(d->sock, message.data(), message.size(), 0, (struct sockaddr *) &d->server, sizeof(d->server));
+    ret = ::sendto(d->sock, datagram.data(), datagram.size(), 0, (struct sockaddr *) &d->server, sizeof(d->server));
     if ( ret == -1) {
         snprintf(d->errmsg, sizeof(d->errmsg),
                 "sendto server fail, host=%s:%d, err=%m", d->host.c_str(), d->port);
@@ -240,6 +293,107 @@ int StatsdClient::send(const std::string& message)
     return 0;
 }
 
+void StatsdClient::registerHandle(Counter* counter)
+{
+    LOCK(d->cs_handles);
+    d->counters.emplace_back(counter);
+}
+
+void StatsdClient::unregisterHandle(Counter* counter)
+{
+    LOCK(d->cs_handles);
+    d->counters.erase(std::remove(d->counters.begin(), d->counters.end(), counter), d->counters.end());
+}
+
+void StatsdClient::registerHandle(Gauge* gauge)
+{
+    LOCK(d->cs_handles);
+    d->gauges.emplace_back(gauge);
+}
+
+void StatsdClient::unregisterHandle(Gauge* gauge)
+{
+    LOCK(d->cs_handles);
+    d->gauges.erase(std::remove(d->gauges.begin(), d->gauges.end(), gauge), d->gauges.end());
+}
+
+void StatsdClient::Start()
+{
+    if (d->fFlusherRunning) return;
+    // also reads the node name, which is needed to format the keys of registered handles
+    if (WITH_LOCK(d->cs_sock, return init()) != 0) return;
+
+    d->interruptFlusher.reset();
+    d->threadFlusher = std::thread(&TraceThread<std::function<void()> >, "statsd", std::function<void()>(std::bind(&StatsdClient::threadFlush, this)));
+    d->fFlusherRunning = true;
+}
+
+void StatsdClient::Interrupt()
+{
+    d->interruptFlusher();
+}
+
+void StatsdClient::Stop()
+{
+    if (!d->threadFlusher.joinable()) return;
+
+    d->interruptFlusher();
+    d->threadFlusher.join();
+    d->fFlusherRunning = false;
+    // send whatever was queued after the last flush
+    flush();
+}
+
+void StatsdClient::threadFlush()
+{
+    while (d->interruptFlusher.sleep_for(std::chrono::milliseconds(STATSD_FLUSH_INTERVAL_MS))) {
+        flush();
+    }
+}
+
+void StatsdClient::flush()
+{
+    std::vector<std::string> lines;
+    {
+        LOCK(d->cs_queue);
+        lines.swap(d->queue);
+        if (d->nDropped > 0) {
+            lines.emplace_back(format("statsd.dropped", strprintf("%d", d->nDropped), "c", 1.0f));
+            d->nDropped = 0;
+        }
+    }
+    {
+        LOCK(d->cs_handles);
+        for (Counter* counter : d->counters) {
+            int64_t value = counter->m_value.exchange(0, std::memory_order_relaxed);
+            if (value != 0) {
+                lines.emplace_back(format(counter->m_key, strprintf("%d", value), "c", 1.0f));
+            }
+        }
+        for (Gauge* gauge : d->gauges) {
+            if (gauge->m_dirty.exchange(false, std::memory_order_acquire)) {
+                lines.emplace_back(format(gauge->m_key, strprintf("%d", gauge->m_value.load(std::memory_order_relaxed)), "g", 1.0f));
+            }
+        }
+    }
+
+    // pack as many metrics as fit into each datagram, separated by newlines
+    std::string datagram;
+    for (const std::string& line : lines) {
+        if (!datagram.empty() && datagram.size() + 1 + line.size() > MAX_STATSD_DATAGRAM_SIZE) {
+            sendDatagram(datagram);
+            datagram.clear();
+        }
+        if (!datagram.empty()) {
+            datagram += '\n';
+        }
+        datagram += line;
+    }
+    if (!datagram.empty()) {
+        sendDatagram(datagram);
+    }
+}
+
 const char* StatsdClient::errmsg()
 {
     return d->errmsg;
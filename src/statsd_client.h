@@ -1,6 +1,7 @@
 #ifndef BITCOIN_STATSD_CLIENT_H
 #define BITCOIN_STATSD_CLIENT_H
 
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -15,9 +16,58 @@ static const int DEFAULT_STATSD_PERIOD = 60;
 static const int MIN_STATSD_PERIOD = 5;
 static const int MAX_STATSD_PERIOD = 60 * 60;
 
+// interval at which queued metrics and registered handles are sent, in milliseconds
+static const int STATSD_FLUSH_INTERVAL_MS = 1000;
+// metrics are packed into datagrams of at most this size (ethernet MTU minus IPv4 and UDP headers)
+static const size_t MAX_STATSD_DATAGRAM_SIZE = 1472;
+// queued metrics are dropped when the flusher falls behind this far
+static const size_t MAX_STATSD_QUEUE_SIZE = 16384;
+
 namespace statsd {
 
 struct _StatsdClientData;
+class StatsdClient;
+
+/**
+ * Counter registered once with the client. Adding to it is a single atomic operation, the accumulated value is sent by
+ * the flusher thread. Meant for hot paths where building the key and queueing a metric per event is too expensive.
+ */
+class Counter {
+    public:
+        Counter(StatsdClient& client, const std::string& key);
+        ~Counter();
+
+        void Add(int64_t value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+        void Inc() { Add(1); }
+
+    private:
+        friend class StatsdClient;
+
+        StatsdClient& m_client;
+        const std::string m_key;
+        std::atomic<int64_t> m_value{0};
+};
+
+/** Gauge registered once with the client, only the last value set before a flush is sent */
+class Gauge {
+    public:
+        Gauge(StatsdClient& client, const std::string& key);
+        ~Gauge();
+
+        void Set(int64_t value)
+        {
+            m_value.store(value, std::memory_order_relaxed);
+            m_dirty.store(true, std::memory_order_release);
+        }
+
+    private:
+        friend class StatsdClient;
+
+        StatsdClient& m_client;
+        const std::string m_key;
+        std::atomic<int64_t> m_value{0};
+        std::atomic<bool> m_dirty{false};
+};
 
 class StatsdClient {
     public:
@@ -29,6 +79,14 @@ class StatsdClient {
         void config(const std::string& host, int port, const std::string& ns = DEFAULT_STATSD_NAMESPACE);
         const char* errmsg();
 
+        /**
+         * Start the flusher thread. Until it is started (and after it is stopped) metrics are sent immediately,
+         * one datagram each, and registered handles are not sent at all.
+         */
+        void Start();
+        void Interrupt();
+        void Stop();
+
     public:
         int inc(const std::string& key, float sample_rate = 1.0);
         int dec(const std::string& key, float sample_rate = 1.0);
@@ -53,8 +111,21 @@ class StatsdClient {
                 const std::string& type, float sample_rate);
 
     protected:
+        friend class Counter;
+        friend class Gauge;
+
         int init();
         static void cleanup(std::string& key);
+        std::string format(std::string key, const std::string& value, const std::string& type, float sample_rate);
+        int sendDatagram(const std::string& datagram);
+
+        void registerHandle(Counter* counter);
+        void unregisterHandle(Counter* counter);
+        void registerHandle(Gauge* gauge);
+        void unregisterHandle(Gauge* gauge);
+
+        void threadFlush();
+        void flush();
 
     protected:
         std::unique_ptr<struct _StatsdClientData> d;
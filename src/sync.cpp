@@ -22,6 +22,35 @@
 #include <utility>
 #include <vector>
 
+void LockWaitTracker::Add(const char* pszName, std::chrono::microseconds wait)
+{
+    if (pszName[0] == ':' && pszName[1] == ':') pszName += 2;
+    m_waits[pszName] += wait;
+}
+
+#ifdef HAVE_THREAD_LOCAL
+static thread_local LockWaitTracker* g_lock_wait_tracker{nullptr};
+
+LockWaitTracker::LockWaitTracker() : m_prev(g_lock_wait_tracker)
+{
+    g_lock_wait_tracker = this;
+}
+
+LockWaitTracker::~LockWaitTracker()
+{
+    g_lock_wait_tracker = m_prev;
+}
+
+LockWaitTracker* LockWaitTracker::Current()
+{
+    return g_lock_wait_tracker;
+}
+#else
+LockWaitTracker::LockWaitTracker() : m_prev(nullptr) {}
+LockWaitTracker::~LockWaitTracker() {}
+LockWaitTracker* LockWaitTracker::Current() { return nullptr; }
+#endif
+
 #ifdef DEBUG_LOCKCONTENTION
 #if !defined(HAVE_THREAD_LOCAL)
 static_assert(false, "thread_local is not supported");
@@ -9,7 +9,9 @@
 #include <threadsafety.h>
 #include <util/macros.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -127,6 +129,35 @@ typedef AnnotatedMixin<std::mutex> Mutex;
 void PrintLockContention(const char* pszName, const char* pszFile, int nLine);
 #endif
 
+/**
+ * Collects the time the current thread spends waiting for contended locks,
+ * per lock name, while the tracker is alive. This allows to attribute lock
+ * contention to a unit of work done by a thread, like an RPC call.
+ *
+ * Requires thread_local support, nothing is collected otherwise.
+ */
+class LockWaitTracker
+{
+public:
+    LockWaitTracker();
+    ~LockWaitTracker();
+    LockWaitTracker(const LockWaitTracker&) = delete;
+    LockWaitTracker& operator=(const LockWaitTracker&) = delete;
+
+    /** The innermost tracker of the current thread, if any */
+    static LockWaitTracker* Current();
+
+    /** Add a wait for the lock named pszName. A leading "::" is stripped, so that one mutex
+     *  locked as both ::mempool.cs and mempool.cs is reported once. */
+    void Add(const char* pszName, std::chrono::microseconds wait);
+    /** Waiting time per lock name */
+    const std::map<std::string, std::chrono::microseconds>& GetWaits() const { return m_waits; }
+
+private:
+    std::map<std::string, std::chrono::microseconds> m_waits;
+    LockWaitTracker* const m_prev;
+};
+
 /** Wrapper around std::unique_lock style lock for Mutex. */
 template <typename Mutex, typename Base = typename Mutex::UniqueLock>
 class SCOPED_LOCKABLE UniqueLock : public Base
@@ -135,14 +166,26 @@ private:
     void Enter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, (void*)(Base::mutex()));
-#ifdef DEBUG_LOCKCONTENTION
+        LockWaitTracker* tracker = LockWaitTracker::Current();
+#ifndef DEBUG_LOCKCONTENTION
+        // Nothing to report, so don't pay for the try_lock
+        if (!tracker) {
+            Base::lock();
+            return;
+        }
+#endif
         if (!Base::try_lock()) {
+#ifdef DEBUG_LOCKCONTENTION
             PrintLockContention(pszName, pszFile, nLine);
 #endif
-            Base::lock();
-#ifdef DEBUG_LOCKCONTENTION
+            if (tracker) {
+                const auto start = std::chrono::steady_clock::now();
+                Base::lock();
+                tracker->Add(pszName, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+            } else {
+                Base::lock();
+            }
         }
-#endif
     }
 
     bool TryEnter(const char* pszName, const char* pszFile, int nLine)
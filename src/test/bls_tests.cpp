@@ -4,7 +4,9 @@
 
 #include <bls/bls.h>
 #include <bls/bls_batchverifier.h>
+#include <clientversion.h>
 #include <random.h>
+#include <streams.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -203,6 +205,40 @@ BOOST_AUTO_TEST_CASE(bls_dh_exchange_tests)
     BOOST_CHECK(pke1 == pke2);
 }
 
+BOOST_AUTO_TEST_CASE(bls_pubkey_cache_tests)
+{
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    CBLSPublicKey pk = sk.GetPublicKey();
+
+    CDataStream ds(SER_DISK, CLIENT_VERSION);
+    ds << pk;
+    const std::vector<uint8_t> vecBytes(ds.begin(), ds.end());
+
+    // First one decodes and caches the key, the others are served from the cache
+    for (int i = 0; i < 3; i++) {
+        CDataStream ds2(vecBytes, SER_DISK, CLIENT_VERSION);
+        CBLSPublicKey pk2;
+        ds2 >> pk2;
+        BOOST_CHECK(pk2.IsValid());
+        BOOST_CHECK(pk2 == pk);
+        BOOST_CHECK(pk2.GetHash() == pk.GetHash());
+    }
+
+    CBLSPublicKey pk3;
+    pk3.SetByteVector(vecBytes);
+    BOOST_CHECK(pk3 == pk);
+
+    // Invalid encodings must never be cached and keep being rejected
+    const std::vector<uint8_t> vecInvalid(CBLSPublicKey::SerSize, 0xff);
+    for (int i = 0; i < 2; i++) {
+        CDataStream ds3(vecInvalid, SER_DISK, CLIENT_VERSION);
+        CBLSPublicKey pk4;
+        BOOST_CHECK_THROW(ds3 >> pk4, std::ios_base::failure);
+        BOOST_CHECK(!pk4.IsValid());
+    }
+}
+
 struct Message
 {
     uint32_t sourceId;
@@ -12,6 +12,7 @@
 #include <undo.h>
 #include <util/strencodings.h>
 
+#include <future>
 #include <map>
 #include <vector>
 
@@ -53,7 +54,7 @@ public:
 
     uint256 GetBestBlock() const override { return hashBestBlock_; }
 
-    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase) override
     {
         for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); ) {
             if (it->second.flags & CCoinsCacheEntry::DIRTY) {
@@ -64,7 +65,11 @@ public:
                     map_.erase(it->first);
                 }
             }
-            mapCoins.erase(it++);
+            if (erase) {
+                mapCoins.erase(it++);
+            } else {
+                ++it;
+            }
         }
         if (!hashBlock.IsNull())
             hashBestBlock_ = hashBlock;
@@ -212,11 +217,15 @@ void SimulationTest(CCoinsView* base, bool fake_best_block)
         }
 
         if (InsecureRandRange(100) == 0) {
-            // Every 100 iterations, flush an intermediate cache
+            // Every 100 iterations, flush or sync an intermediate cache
             if (stack.size() > 1 && InsecureRandBool() == 0) {
                 unsigned int flushIndex = InsecureRandRange(stack.size() - 1);
                 if (fake_best_block) stack[flushIndex]->SetBestBlock(InsecureRand256());
-                BOOST_CHECK(stack[flushIndex]->Flush());
+                if (InsecureRandBool()) {
+                    BOOST_CHECK(stack[flushIndex]->Flush());
+                } else {
+                    BOOST_CHECK(stack[flushIndex]->Sync());
+                }
             }
         }
         if (InsecureRandRange(100) == 0) {
@@ -608,9 +617,10 @@ void GetCoinsMapEntry(const CCoinsMap& map, CAmount& value, char& flags)
 
 void WriteCoinsViewEntry(CCoinsView& view, CAmount value, char flags)
 {
-    CCoinsMap map;
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map{0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &resource};
     InsertCoinsMapEntry(map, value, flags);
-    BOOST_CHECK(view.BatchWrite(map, {}));
+    BOOST_CHECK(view.BatchWrite(map, {}, /*erase=*/true));
 }
 
 class SingleEntryCacheTest
@@ -877,4 +887,144 @@ BOOST_AUTO_TEST_CASE(ccoins_write)
                     CheckWriteCoins(parent_value, child_value, parent_value, parent_flags, child_flags, parent_flags);
 }
 
+BOOST_AUTO_TEST_CASE(ccoins_emplace_from_base)
+{
+    CCoinsViewTest base;
+    CCoinsViewCacheTest cache(&base);
+
+    auto make_coin = [](CAmount value) {
+        Coin coin;
+        coin.out.nValue = value;
+        coin.nHeight = 1;
+        return coin;
+    };
+
+    // a coin fetched from the base is added as a clean entry
+    COutPoint outpoint1(InsecureRand256(), 0);
+    BOOST_CHECK(cache.EmplaceCoinFromBase(outpoint1, make_coin(1)));
+    BOOST_CHECK(cache.HaveCoinInCache(outpoint1));
+    BOOST_CHECK_EQUAL(cache.map().at(outpoint1).flags, 0);
+    BOOST_CHECK_EQUAL(cache.AccessCoin(outpoint1).out.nValue, 1);
+    cache.SelfTest();
+
+    // an existing entry is not replaced
+    BOOST_CHECK(!cache.EmplaceCoinFromBase(outpoint1, make_coin(2)));
+    BOOST_CHECK_EQUAL(cache.AccessCoin(outpoint1).out.nValue, 1);
+
+    // a coin spent in the cache must not be brought back by a stale read from the base
+    COutPoint outpoint2(InsecureRand256(), 0);
+    BOOST_CHECK(cache.EmplaceCoinFromBase(outpoint2, make_coin(3)));
+    BOOST_CHECK(cache.SpendCoin(outpoint2));
+    BOOST_CHECK(!cache.EmplaceCoinFromBase(outpoint2, make_coin(3)));
+    BOOST_CHECK(!cache.HaveCoin(outpoint2));
+    cache.SelfTest();
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_sync)
+{
+    CCoinsViewTest base;
+    CCoinsViewCacheTest cache(&base);
+
+    Coin coin;
+    coin.out.nValue = 1;
+    coin.nHeight = 1;
+
+    COutPoint added(InsecureRand256(), 0);
+    cache.AddCoin(added, Coin(coin), false);
+    COutPoint spent(InsecureRand256(), 0);
+    cache.AddCoin(spent, Coin(coin), false);
+    BOOST_CHECK(cache.Sync());
+    BOOST_CHECK(cache.SpendCoin(spent));
+    cache.SetBestBlock(InsecureRand256());
+
+    // dirty entries are written to the base, unspent ones stay cached but are no longer dirty
+    BOOST_CHECK(cache.Sync());
+    cache.SelfTest();
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 1U);
+    BOOST_CHECK_EQUAL(cache.map().at(added).flags, 0);
+    BOOST_CHECK(!cache.HaveCoin(spent));
+    BOOST_CHECK(base.GetBestBlock() == cache.GetBestBlock());
+    {
+        CCoinsViewCacheTest check(&base);
+        BOOST_CHECK(check.HaveCoin(added));
+        BOOST_CHECK(!check.HaveCoin(spent));
+    }
+
+    // the clean entries are simply dropped by a later flush
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+    BOOST_CHECK(cache.HaveCoin(added));
+}
+
+//! Holds back writes to its base until released
+class CCoinsViewGated : public CCoinsViewBacked
+{
+public:
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future()};
+
+    using CCoinsViewBacked::CCoinsViewBacked;
+
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase) override
+    {
+        released.wait();
+        return base->BatchWrite(mapCoins, hashBlock, erase);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(ccoins_background_writer)
+{
+    Coin coin;
+    coin.out.nValue = 1;
+    coin.nHeight = 1;
+
+    CCoinsViewTest base;
+    COutPoint spent(InsecureRand256(), 0);
+    {
+        CCoinsViewCacheTest setup(&base);
+        setup.AddCoin(spent, Coin(coin), false);
+        setup.SetBestBlock(InsecureRand256());
+        BOOST_CHECK(setup.Flush());
+    }
+    const uint256 oldBestBlock = base.GetBestBlock();
+    auto base_has = [&](const COutPoint& outpoint) {
+        CCoinsViewCacheTest check(&base);
+        return check.HaveCoin(outpoint);
+    };
+
+    CCoinsViewGated gated(&base);
+    CCoinsViewBackgroundWriter writer(&gated);
+    CCoinsViewCacheTest cache(&writer);
+
+    BOOST_CHECK(cache.SpendCoin(spent));
+    COutPoint added(InsecureRand256(), 0);
+    cache.AddCoin(added, Coin(coin), false);
+    const uint256 newBestBlock = InsecureRand256();
+    cache.SetBestBlock(newBestBlock);
+
+    // Sync returns while the write is still held back, readers see the synced state nevertheless
+    BOOST_CHECK(cache.Sync());
+    BOOST_CHECK(!cache.HaveCoinInCache(spent));
+    BOOST_CHECK(!writer.HaveCoin(spent));
+    BOOST_CHECK(writer.HaveCoin(added));
+    BOOST_CHECK(writer.GetBestBlock() == newBestBlock);
+    BOOST_CHECK(writer.DynamicMemoryUsage() > 0);
+    BOOST_CHECK(base_has(spent));
+    BOOST_CHECK(!base_has(added));
+    BOOST_CHECK(base.GetBestBlock() == oldBestBlock);
+
+    gated.release.set_value();
+    BOOST_CHECK(writer.WaitForWrite());
+    BOOST_CHECK(!base_has(spent));
+    BOOST_CHECK(base_has(added));
+    BOOST_CHECK(base.GetBestBlock() == newBestBlock);
+    BOOST_CHECK_EQUAL(writer.DynamicMemoryUsage(), 0U);
+
+    // a flush hands over its entries and is written synchronously
+    COutPoint added2(InsecureRand256(), 0);
+    cache.AddCoin(added2, Coin(coin), false);
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(base_has(added2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
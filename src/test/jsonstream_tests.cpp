@@ -0,0 +1,139 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+#include <rpc/server.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+#include <thread>
+
+#include <univalue.h>
+
+BOOST_FIXTURE_TEST_SUITE(jsonstream_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(jsonstream_matches_univalue)
+{
+    UniValue inner(UniValue::VOBJ);
+    inner.pushKV("a", 1);
+    inner.pushKV("quote\"d", "line\nbreak");
+    UniValue arr(UniValue::VARR);
+    arr.push_back(inner);
+    arr.push_back(UniValue(UniValue::VARR));
+    arr.push_back(NullUniValue);
+
+    UniValue expected(UniValue::VOBJ);
+    expected.pushKV("first", true);
+    expected.pushKV("list", arr);
+    expected.pushKV("empty", UniValue(UniValue::VOBJ));
+    expected.pushKV("last", 1.5);
+
+    std::string out;
+    size_t chunks = 0;
+    JSONStreamWriter stream([&](const std::string& chunk) {
+        out += chunk;
+        ++chunks;
+    }, 8);
+    BOOST_CHECK(!stream.Used());
+    stream.BeginObject();
+    stream.KeyValue("first", true);
+    stream.Key("list");
+    stream.BeginArray();
+    stream.BeginObject();
+    stream.KeyValues(inner);
+    stream.EndObject();
+    stream.BeginArray();
+    stream.EndArray();
+    stream.Value(NullUniValue);
+    stream.EndArray();
+    stream.Key("empty");
+    stream.BeginObject();
+    stream.EndObject();
+    stream.KeyValue("last", 1.5);
+    stream.EndObject();
+    BOOST_CHECK(stream.Used());
+    // Output only reaches the sink in chunks of at least the flush size
+    BOOST_CHECK(chunks > 1);
+    BOOST_CHECK(out.size() < stream.GetBytesWritten());
+    stream.Flush();
+
+    BOOST_CHECK_EQUAL(out, expected.write());
+    BOOST_CHECK_EQUAL(stream.GetBytesWritten(), out.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(jsonstream_rpc, TestChain100Setup)
+{
+    // Streamed RPC results are identical to the results built as UniValue
+    const std::string tip_hash = WITH_LOCK(cs_main, return ::ChainActive().Tip()->GetBlockHash().GetHex());
+    for (const auto& [method, params] : std::vector<std::pair<std::string, std::vector<UniValue>>>{
+             {"getblock", {tip_hash, 1}},
+             {"getblock", {tip_hash, 2}},
+             {"getrawmempool", {false}},
+             {"getrawmempool", {true}},
+         }) {
+        JSONRPCRequest request;
+        request.strMethod = method;
+        request.params = UniValue(UniValue::VARR);
+        for (const UniValue& param : params) request.params.push_back(param);
+
+        const std::string expected = tableRPC.execute(request).write();
+
+        std::string out;
+        JSONStreamWriter stream([&](const std::string& chunk) { out += chunk; }, 64);
+        request.stream = &stream;
+        BOOST_CHECK(tableRPC.execute(request).isNull());
+        stream.Flush();
+        BOOST_CHECK_EQUAL(out, expected);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(jsonstream_stalled_client, TestChain100Setup)
+{
+    // A client which doesn't read its streamed getblock reply must not keep other calls from taking cs_main
+    const std::string tip_hash = WITH_LOCK(cs_main, return ::ChainActive().Tip()->GetBlockHash().GetHex());
+    std::promise<void> stalled;
+    std::promise<void> resume;
+    std::shared_future<void> resumed = resume.get_future().share();
+    bool first_chunk{true};
+    JSONStreamWriter stream([&](const std::string& chunk) {
+        // Like WriteReplyChunk when the client stopped reading
+        if (first_chunk) {
+            first_chunk = false;
+            stalled.set_value();
+            resumed.wait();
+        }
+    }, 64);
+
+    std::thread streaming([&] {
+        JSONRPCRequest request;
+        request.strMethod = "getblock";
+        request.params = UniValue(UniValue::VARR);
+        request.params.push_back(tip_hash);
+        request.params.push_back(2);
+        request.stream = &stream;
+        tableRPC.execute(request);
+    });
+    stalled.get_future().wait();
+
+    bool cs_main_free;
+    {
+        TRY_LOCK(cs_main, locked);
+        cs_main_free = locked;
+    }
+    BOOST_CHECK(cs_main_free);
+    if (cs_main_free) {
+        JSONRPCRequest request;
+        request.strMethod = "getblockcount";
+        request.params = UniValue(UniValue::VARR);
+        BOOST_CHECK_EQUAL(tableRPC.execute(request).get_int(), 100);
+    }
+
+    resume.set_value();
+    streaming.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
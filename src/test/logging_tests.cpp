@@ -7,6 +7,8 @@
 #include <test/util/setup_common.h>
 
 #include <chrono>
+#include <thread>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -33,4 +35,89 @@ BOOST_AUTO_TEST_CASE(logging_timer)
     SetMockTime(0);
 }
 
+BOOST_AUTO_TEST_CASE(logging_ring_buffer)
+{
+    // capacity is rounded up to a power of two
+    BCLog::LogRingBuffer buffer(3);
+    std::string msg;
+    BOOST_CHECK(!buffer.TryPop(msg));
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 4; i++) {
+            msg = strprintf("msg %d", i);
+            BOOST_CHECK(buffer.TryPush(msg));
+        }
+        msg = "overflow";
+        BOOST_CHECK(!buffer.TryPush(msg));
+        BOOST_CHECK_EQUAL(msg, "overflow");
+
+        for (int i = 0; i < 4; i++) {
+            BOOST_CHECK(buffer.TryPop(msg));
+            BOOST_CHECK_EQUAL(msg, strprintf("msg %d", i));
+        }
+        BOOST_CHECK(!buffer.TryPop(msg));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(logging_ring_buffer_producers)
+{
+    BCLog::LogRingBuffer buffer(64);
+    const int nProducers = 4;
+    const int nMessages = 1000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < nProducers; p++) {
+        producers.emplace_back([&buffer, p] {
+            for (int i = 0; i < nMessages; i++) {
+                std::string msg = strprintf("%d %d", p, i);
+                while (!buffer.TryPush(msg)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // messages of each producer must arrive complete and in order
+    std::vector<int> next(nProducers, 0);
+    std::string msg;
+    for (int received = 0; received < nProducers * nMessages;) {
+        if (!buffer.TryPop(msg)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int p, i;
+        BOOST_REQUIRE(sscanf(msg.c_str(), "%d %d", &p, &i) == 2);
+        BOOST_CHECK_EQUAL(i, next[p]++);
+        received++;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    BOOST_CHECK(!buffer.TryPop(msg));
+}
+
+BOOST_AUTO_TEST_CASE(logging_async)
+{
+    std::vector<std::string> msgs;
+    auto it = LogInstance().PushBackCallback([&msgs](const std::string& s) {
+        // skip the start/exit messages of the writer thread
+        if (s.find("async ") != std::string::npos) msgs.push_back(s);
+    });
+
+    LogInstance().StartAsyncWriter(16, false);
+    BOOST_CHECK(LogInstance().IsAsync());
+    for (int i = 0; i < 100; i++) {
+        LogPrintf("async %d\n", i);
+    }
+    // stopping writes everything still queued
+    LogInstance().StopAsyncWriter();
+    BOOST_CHECK(!LogInstance().IsAsync());
+    LogInstance().DeleteCallback(it);
+
+    BOOST_REQUIRE_EQUAL(msgs.size(), 100U);
+    for (int i = 0; i < 100; i++) {
+        BOOST_CHECK(msgs[i].find(strprintf("async %d\n", i)) != std::string::npos);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -788,4 +788,74 @@ BOOST_AUTO_TEST_CASE(MempoolAncestryTests)
     BOOST_CHECK_EQUAL(descendants, 4ULL);
 }
 
+BOOST_AUTO_TEST_CASE(MempoolSnapshotTest)
+{
+    TestMemPoolEntryHelper entry;
+    CTxMemPool pool;
+
+    CMutableTransaction txParent;
+    txParent.vin.resize(1);
+    txParent.vin[0].scriptSig = CScript() << OP_11;
+    txParent.vout.resize(2);
+    for (int i = 0; i < 2; i++) {
+        txParent.vout[i].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+        txParent.vout[i].nValue = 10000LL;
+    }
+    CMutableTransaction txChild;
+    txChild.vin.resize(1);
+    txChild.vin[0].scriptSig = CScript() << OP_11;
+    txChild.vin[0].prevout = COutPoint(txParent.GetHash(), 0);
+    txChild.vout.resize(1);
+    txChild.vout[0].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+    txChild.vout[0].nValue = 9000LL;
+
+    auto snapshot = pool.GetSnapshot();
+    BOOST_CHECK(snapshot->vEntries.empty());
+    // unchanged pool, same snapshot
+    BOOST_CHECK(pool.GetSnapshot() == snapshot);
+
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.addUnchecked(entry.Fee(1000LL).FromTx(txParent));
+        pool.addUnchecked(entry.Fee(2000LL).FromTx(txChild));
+    }
+
+    // the old snapshot is not modified, a new one is taken
+    BOOST_CHECK(snapshot->vEntries.empty());
+    snapshot = pool.GetSnapshot();
+    BOOST_CHECK_EQUAL(snapshot->vEntries.size(), 2U);
+    BOOST_CHECK(pool.GetSnapshot() == snapshot);
+
+    // entries are in the order of queryHashes(), i.e. parents first
+    std::vector<uint256> vtxid;
+    pool.queryHashes(vtxid);
+    for (size_t i = 0; i < vtxid.size(); i++) {
+        BOOST_CHECK(snapshot->vEntries[i].entry.GetTx().GetHash() == vtxid[i]);
+    }
+
+    const CTxMemPoolSnapshotEntry* parent = snapshot->Find(txParent.GetHash());
+    const CTxMemPoolSnapshotEntry* child = snapshot->Find(txChild.GetHash());
+    BOOST_REQUIRE(parent && child);
+    BOOST_CHECK(snapshot->Find(InsecureRand256()) == nullptr);
+    BOOST_CHECK(parent->vParents.empty());
+    BOOST_CHECK(parent->vChildren == std::vector<uint256>{txChild.GetHash()});
+    BOOST_CHECK(child->vParents == std::vector<uint256>{txParent.GetHash()});
+    BOOST_CHECK(child->vChildren.empty());
+    BOOST_CHECK_EQUAL(parent->entry.GetModFeesWithDescendants(), 3000LL);
+    BOOST_CHECK_EQUAL(child->entry.GetCountWithAncestors(), 2U);
+
+    // prioritising a transaction changes its fees, so the snapshot is refreshed
+    pool.PrioritiseTransaction(txChild.GetHash(), 500LL);
+    snapshot = pool.GetSnapshot();
+    BOOST_CHECK_EQUAL(snapshot->Find(txChild.GetHash())->entry.GetModifiedFee(), 2500LL);
+    BOOST_CHECK_EQUAL(snapshot->Find(txParent.GetHash())->entry.GetModFeesWithDescendants(), 3500LL);
+
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.removeRecursive(CTransaction(txParent), REMOVAL_REASON_DUMMY);
+    }
+    BOOST_CHECK_EQUAL(snapshot->vEntries.size(), 2U);
+    BOOST_CHECK(pool.GetSnapshot()->vEntries.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
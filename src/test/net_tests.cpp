@@ -710,5 +710,30 @@ BOOST_AUTO_TEST_CASE(LocalAddress_BasicLifecycle)
     BOOST_CHECK_EQUAL(IsLocal(addr), false);
 }
 
+BOOST_AUTO_TEST_CASE(shared_payload_transport)
+{
+    const std::vector<unsigned char> payload{ParseHex("0123456789abcdef0123456789abcdef")};
+
+    CSerializedNetMsg msg;
+    msg.command = "block";
+    msg.data = payload;
+
+    CSerializedNetMsg msgShared;
+    msgShared.command = "block";
+    msgShared.shared_payload = std::make_shared<const CSharedNetMsgPayload>(std::vector<unsigned char>(payload));
+    BOOST_CHECK_EQUAL(msgShared.PayloadSize(), payload.size());
+
+    // Shared payloads must produce the exact same header (size and checksum) as owned ones
+    V1TransportSerializer serializer;
+    std::vector<unsigned char> header, headerShared;
+    serializer.prepareForTransport(msg, header);
+    serializer.prepareForTransport(msgShared, headerShared);
+    BOOST_CHECK(header == headerShared);
+
+    CSendMsgBuffer buffer(std::move(msg.data));
+    CSendMsgBuffer bufferShared(msgShared.shared_payload);
+    BOOST_CHECK_EQUAL(buffer.size(), bufferShared.size());
+    BOOST_CHECK(std::equal(buffer.data(), buffer.data() + buffer.size(), bufferShared.data()));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+// Copyright (c) 2022 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <memusage.h>
+#include <support/allocators/pool.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(pool_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(basic_allocating)
+{
+    auto resource = PoolResource<8, 8>(1024);
+    // no chunk is allocated before the first allocation
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 0U);
+
+    // first chunk is allocated, and the block is carved out of it
+    void* block = resource.Allocate(8, 8);
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 1U);
+
+    // a deallocated block is reused for the next allocation of the same size
+    resource.Deallocate(block, 8, 8);
+    BOOST_CHECK(block == resource.Allocate(8, 8));
+    resource.Deallocate(block, 8, 8);
+
+    // 0 bytes takes one entry from the first freelist
+    void* b = resource.Allocate(0, 1);
+    BOOST_CHECK(block == b);
+    resource.Deallocate(b, 0, 1);
+
+    // too large for the pool, falls back to operator new and doesn't touch the freelist
+    b = resource.Allocate(16, 8);
+    BOOST_CHECK(b != block);
+    resource.Deallocate(b, 16, 8);
+    BOOST_CHECK(block == resource.Allocate(8, 8));
+
+    // alignment too large for the pool
+    b = resource.Allocate(8, 16);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(b) % 16, 0U);
+    resource.Deallocate(b, 8, 16);
+
+    // using the whole chunk allocates a new one
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 1024 / 8; ++i) {
+        blocks.push_back(resource.Allocate(8, 8));
+    }
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 2U);
+    for (void* p : blocks) {
+        resource.Deallocate(p, 8, 8);
+    }
+    resource.Deallocate(block, 8, 8);
+}
+
+BOOST_AUTO_TEST_CASE(random_allocations)
+{
+    struct PtrSizeAlignment {
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    // makes a bunch of random allocations and gives all of them back in random order.
+    auto resource = PoolResource<128, 8>(65536);
+    std::vector<PtrSizeAlignment> ptr_size_alignment{};
+    for (size_t i = 0; i < 1000; ++i) {
+        // make it a bit more likely to allocate than deallocate
+        if (ptr_size_alignment.empty() || 0 != InsecureRandRange(4)) {
+            // allocate a random item
+            std::size_t alignment = std::size_t{1} << InsecureRandRange(8);          // 1, 2, ..., 128
+            std::size_t size = (InsecureRandRange(200) / alignment + 1) * alignment; // multiple of alignment
+            void* ptr = resource.Allocate(size, alignment);
+            BOOST_CHECK(ptr != nullptr);
+            BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(ptr) % alignment, 0U);
+            // overwrite the whole block to catch overlaps with other allocations (when run with sanitizers)
+            std::fill_n(static_cast<unsigned char*>(ptr), size, (unsigned char)i);
+            ptr_size_alignment.push_back({ptr, size, alignment});
+        } else {
+            // deallocate a random item
+            auto& x = ptr_size_alignment[InsecureRandRange(ptr_size_alignment.size())];
+            resource.Deallocate(x.ptr, x.bytes, x.alignment);
+            x = ptr_size_alignment.back();
+            ptr_size_alignment.pop_back();
+        }
+    }
+
+    // deallocate all the rest
+    for (auto const& x : ptr_size_alignment) {
+        resource.Deallocate(x.ptr, x.bytes, x.alignment);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(memusage_test)
+{
+    auto std_map = std::unordered_map<int, int>{};
+
+    using Map = std::unordered_map<int,
+                                   int,
+                                   std::hash<int>,
+                                   std::equal_to<int>,
+                                   PoolAllocator<std::pair<const int, int>,
+                                                 sizeof(std::pair<const int, int>) + sizeof(void*) * 4>>;
+    auto resource = Map::allocator_type::ResourceType(1024);
+
+    {
+        auto resource_map = Map{0, std::hash<int>{}, std::equal_to<int>{}, &resource};
+
+        // can't have the same resource usage
+        BOOST_TEST(memusage::DynamicUsage(std_map) != memusage::DynamicUsage(resource_map));
+
+        for (size_t i = 0; i < 10000; ++i) {
+            std_map[i];
+            resource_map[i];
+        }
+
+        // Eventually the resource_map should have a much lower memory usage because it has less malloc overhead
+        BOOST_TEST(memusage::DynamicUsage(resource_map) <= memusage::DynamicUsage(std_map) * 90 / 100);
+
+        // Make sure the pool is actually used by the nodes
+        auto max_nodes_per_chunk = resource.ChunkSizeBytes() / sizeof(Map::value_type);
+        auto min_num_allocated_chunks = resource_map.size() / max_nodes_per_chunk + 1;
+        BOOST_TEST(resource.NumAllocatedChunks() >= min_num_allocated_chunks);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
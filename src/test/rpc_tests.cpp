@@ -9,12 +9,16 @@
 #include <core_io.h>
 #include <init.h>
 #include <interfaces/chain.h>
+#include <node/blockstats.h>
 #include <test/util/setup_common.h>
 #include <util/time.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <numeric>
+
 #include <univalue.h>
 
 #include <rpc/blockchain.h>
@@ -417,4 +421,59 @@ BOOST_AUTO_TEST_CASE(rpc_getblockstats_calculate_percentiles_by_size)
     }
 }
 
+static const size_t PARALLEL_SUM_SIZE = 64;
+
+static UniValue parallelsum(const JSONRPCRequest& request)
+{
+    std::vector<int64_t> squares(PARALLEL_SUM_SIZE);
+    RPCParallelFor(squares.size(), [&](size_t i) { squares[i] = i * i; });
+    return std::accumulate(squares.begin(), squares.end(), int64_t{0});
+}
+
+BOOST_AUTO_TEST_CASE(rpc_parallel_for)
+{
+    // Starts the -rpcbatchthreads pool
+    StartRPC();
+
+    // The results are in order, whichever thread computed them
+    std::vector<size_t> results(1000);
+    RPCParallelFor(results.size(), [&](size_t i) { results[i] = i * 2; });
+    for (size_t i = 0; i < results.size(); ++i) {
+        BOOST_CHECK_EQUAL(results[i], i * 2);
+    }
+
+    // An exception is rethrown once all calls are done
+    std::atomic<size_t> calls{0};
+    BOOST_CHECK_EXCEPTION(RPCParallelFor(100, [&](size_t i) {
+        ++calls;
+        if (i % 10 == 3) throw std::runtime_error("parallel failure");
+    }), std::runtime_error, HasReason("parallel failure"));
+    BOOST_CHECK_EQUAL(calls, 100U);
+
+    // Calls of a batch run on the pool threads, and can use RPCParallelFor themselves
+    const CRPCCommand command{"test", "parallelsum", &parallelsum, {}, /* exclusive */ false};
+    BOOST_CHECK(tableRPC.appendCommand("parallelsum", &command));
+    if (RPCIsInWarmup(nullptr)) SetRPCWarmupFinished();
+    const size_t batch_size = 2 * DEFAULT_RPC_BATCH_THREADS;
+    UniValue batch(UniValue::VARR);
+    for (size_t i = 0; i < batch_size; ++i) {
+        UniValue call(UniValue::VOBJ);
+        call.pushKV("method", "parallelsum");
+        call.pushKV("id", (uint64_t)i);
+        batch.push_back(call);
+    }
+    UniValue reply;
+    BOOST_CHECK(reply.read(JSONRPCExecBatch(JSONRPCRequest(), batch)));
+    BOOST_CHECK_EQUAL(reply.size(), batch_size);
+    const int64_t expected = (PARALLEL_SUM_SIZE - 1) * PARALLEL_SUM_SIZE * (2 * PARALLEL_SUM_SIZE - 1) / 6;
+    for (size_t i = 0; i < reply.size(); ++i) {
+        BOOST_CHECK(find_value(reply[i], "error").isNull());
+        BOOST_CHECK_EQUAL(find_value(reply[i], "id").get_int64(), (int64_t)i);
+        BOOST_CHECK_EQUAL(find_value(reply[i], "result").get_int64(), expected);
+    }
+    BOOST_CHECK(tableRPC.removeCommand("parallelsum", &command));
+
+    StopRPC();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
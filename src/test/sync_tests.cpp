@@ -5,6 +5,11 @@
 #include <sync.h>
 #include <test/util/setup_common.h>
 
+#include <util/time.h>
+
+#include <future>
+#include <thread>
+
 #include <boost/test/unit_test.hpp>
 
 namespace {
@@ -55,4 +60,43 @@ BOOST_AUTO_TEST_CASE(potential_deadlock_detected)
     #endif
 }
 
+#ifdef HAVE_THREAD_LOCAL
+BOOST_AUTO_TEST_CASE(lock_wait_tracker)
+{
+    Mutex mutex;
+    BOOST_CHECK(LockWaitTracker::Current() == nullptr);
+    {
+        LockWaitTracker tracker;
+        BOOST_CHECK(LockWaitTracker::Current() == &tracker);
+        // Uncontended locks are not recorded
+        {
+            LOCK(mutex);
+        }
+        BOOST_CHECK(tracker.GetWaits().empty());
+
+        // Hold the lock in another thread for a while
+        std::promise<void> locked;
+        std::thread holder([&] {
+            LOCK(mutex);
+            locked.set_value();
+            UninterruptibleSleep(std::chrono::milliseconds{50});
+        });
+        locked.get_future().wait();
+        {
+            LOCK(mutex);
+        }
+        holder.join();
+        BOOST_CHECK_EQUAL(tracker.GetWaits().size(), 1U);
+        BOOST_CHECK(tracker.GetWaits().at("mutex") >= std::chrono::milliseconds{10});
+
+        // The same mutex locked with and without the global scope prefix is reported once
+        tracker.Add("::mempool.cs", std::chrono::microseconds{1});
+        tracker.Add("mempool.cs", std::chrono::microseconds{2});
+        BOOST_CHECK_EQUAL(tracker.GetWaits().size(), 2U);
+        BOOST_CHECK(tracker.GetWaits().at("mempool.cs") == std::chrono::microseconds{3});
+    }
+    BOOST_CHECK(LockWaitTracker::Current() == nullptr);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
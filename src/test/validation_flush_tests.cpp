@@ -52,7 +52,8 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
         BOOST_TEST_MESSAGE("CCoinsViewCache memory usage: " << view.DynamicMemoryUsage());
     };
 
-    constexpr size_t MAX_COINS_CACHE_BYTES = 1024;
+    // The coins cache allocates its memory in chunks of 256 KiB (see PoolResource), so make room for one of those.
+    constexpr size_t MAX_COINS_CACHE_BYTES = 262144 + 512;
 
     // Without any coins in the cache, we shouldn't need to flush.
     BOOST_CHECK_EQUAL(
@@ -91,8 +92,13 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
         COutPoint res = add_coin(view);
         print_view_mem_usage(view);
         BOOST_CHECK_EQUAL(view.AccessCoin(res).DynamicMemoryUsage(), COIN_SIZE);
+        // The first coin makes the memory resource allocate its first chunk, which takes us straight to LARGE.
         BOOST_CHECK_EQUAL(
             chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, /*max_mempool_size_bytes*/ 0),
+            CoinsCacheSizeState::LARGE);
+        // With room for a few chunks, a handful of coins is still OK, as it was with per-node accounting.
+        BOOST_CHECK_EQUAL(
+            chainstate.GetCoinsCacheSizeState(tx_pool, 4 * MAX_COINS_CACHE_BYTES, /*max_mempool_size_bytes*/ 0),
             CoinsCacheSizeState::OK);
     }
 
@@ -113,14 +119,14 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
     // Passing non-zero max mempool usage should allow us more headroom.
     BOOST_CHECK_EQUAL(
         chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, /*max_mempool_size_bytes*/ 1 << 10),
-        CoinsCacheSizeState::OK);
+        CoinsCacheSizeState::LARGE);
 
     for (int i{0}; i < 3; ++i) {
         add_coin(view);
         print_view_mem_usage(view);
         BOOST_CHECK_EQUAL(
             chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, /*max_mempool_size_bytes*/ 1 << 10),
-            CoinsCacheSizeState::OK);
+            CoinsCacheSizeState::LARGE);
     }
 
     // Adding another coin with the additional mempool room will put us >90%
@@ -147,8 +153,8 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
             CoinsCacheSizeState::OK);
     }
 
-    // Flushing the view doesn't take us back to OK because cacheCoins has
-    // preallocated memory that doesn't get reclaimed even after flush.
+    // Flushing the view doesn't take us back to OK because cacheCoins keeps
+    // the memory of its pool for reuse after flush.
 
     BOOST_CHECK_EQUAL(
         chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, 0),
@@ -161,6 +167,62 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
     BOOST_CHECK_EQUAL(
         chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, 0),
         CoinsCacheSizeState::CRITICAL);
+
+    // Reallocating the cache gives the memory back.
+    view.ReallocateCache();
+    print_view_mem_usage(view);
+    BOOST_CHECK_EQUAL(
+        chainstate.GetCoinsCacheSizeState(tx_pool, MAX_COINS_CACHE_BYTES, 0),
+        CoinsCacheSizeState::OK);
+}
+
+//! Syncing a LARGE cache must bring it back under the soft threshold by evicting clean coins, instead of letting it
+//! grow until it is CRITICAL and gets wiped.
+//!
+//! @sa CChainState::FlushStateToDisk()
+//!
+BOOST_AUTO_TEST_CASE(large_cache_sync_evicts_clean_coins)
+{
+    BlockManager blockman{};
+    CChainState chainstate{blockman};
+    chainstate.InitCoinsDB(/*cache_size_bytes*/ 1 << 10, /*in_memory*/ true, /*should_wipe*/ false);
+    WITH_LOCK(::cs_main, chainstate.InitCoinsCache());
+    CTxMemPool tx_pool{};
+
+    LOCK(::cs_main);
+    auto& view = chainstate.CoinsTip();
+
+    for (int i{0}; i < 20000; ++i) {
+        Coin newcoin;
+        newcoin.nHeight = 1;
+        newcoin.out.nValue = InsecureRand32();
+        newcoin.out.scriptPubKey.assign((uint32_t)56, 1);
+        view.AddCoin(COutPoint{InsecureRand256(), 0}, std::move(newcoin), false);
+    }
+    view.SetBestBlock(InsecureRand256());
+
+    // Leave 5% of headroom, which is above the soft threshold.
+    const size_t max_coins_cache_bytes = view.DynamicMemoryUsage() * 105 / 100;
+    BOOST_CHECK_EQUAL(
+        chainstate.GetCoinsCacheSizeState(tx_pool, max_coins_cache_bytes, /*max_mempool_size_bytes*/ 0),
+        CoinsCacheSizeState::LARGE);
+
+    BOOST_CHECK(view.Sync());
+    BOOST_CHECK(chainstate.CoinsBackgroundWriter().WaitForWrite());
+    // Syncing alone keeps all coins, and the pool keeps its memory.
+    BOOST_CHECK_EQUAL(view.GetCacheSize(), 20000U);
+    BOOST_CHECK_EQUAL(
+        chainstate.GetCoinsCacheSizeState(tx_pool, max_coins_cache_bytes, /*max_mempool_size_bytes*/ 0),
+        CoinsCacheSizeState::LARGE);
+
+    view.EvictClean(chainstate.GetCoinsTipSoftLimit(tx_pool, max_coins_cache_bytes, /*max_mempool_size_bytes*/ 0));
+    BOOST_TEST_MESSAGE("CCoinsViewCache memory usage: " << view.DynamicMemoryUsage());
+    BOOST_CHECK_EQUAL(
+        chainstate.GetCoinsCacheSizeState(tx_pool, max_coins_cache_bytes, /*max_mempool_size_bytes*/ 0),
+        CoinsCacheSizeState::OK);
+    // Only what was needed to get under the threshold was evicted, the cache stays warm.
+    BOOST_CHECK(view.GetCacheSize() > 10000U);
+    BOOST_CHECK(view.GetCacheSize() < 20000U);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
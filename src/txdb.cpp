@@ -5,6 +5,7 @@
 
 #include <txdb.h>
 
+#include <memusage.h>
 #include <pow.h>
 #include <random.h>
 #include <shutdown.h>
@@ -72,7 +73,7 @@ std::vector<uint256> CCoinsViewDB::GetHeadBlocks() const {
     return vhashHeadBlocks;
 }
 
-bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
+bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) {
     CDBBatch batch(db);
     size_t count = 0;
     size_t changed = 0;
@@ -107,8 +108,11 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
             changed++;
         }
         count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
+        if (erase) {
+            it = mapCoins.erase(it);
+        } else {
+            ++it;
+        }
         if (batch.SizeEstimate() > batch_size) {
             LogPrint(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.SizeEstimate() * (1.0 / 1048576.0));
             db.WriteBatch(batch);
@@ -138,6 +142,121 @@ size_t CCoinsViewDB::EstimateSize() const
     return db.EstimateSize(DB_COIN, (char)(DB_COIN+1));
 }
 
+CCoinsViewBackgroundWriter::~CCoinsViewBackgroundWriter()
+{
+    WaitForWrite();
+}
+
+bool CCoinsViewBackgroundWriter::GetCoin(const COutPoint &outpoint, Coin &coin) const
+{
+    {
+        LOCK(m_mutex);
+        if (m_pending) {
+            auto it = m_pending->coins.find(outpoint);
+            if (it != m_pending->coins.end()) {
+                if (it->second.coin.IsSpent()) return false;
+                coin = it->second.coin;
+                return true;
+            }
+        }
+    }
+    // Coins which are not part of the pending write are not touched by it
+    return base->GetCoin(outpoint, coin);
+}
+
+bool CCoinsViewBackgroundWriter::HaveCoin(const COutPoint &outpoint) const
+{
+    {
+        LOCK(m_mutex);
+        if (m_pending) {
+            auto it = m_pending->coins.find(outpoint);
+            if (it != m_pending->coins.end()) {
+                return !it->second.coin.IsSpent();
+            }
+        }
+    }
+    return base->HaveCoin(outpoint);
+}
+
+uint256 CCoinsViewBackgroundWriter::GetBestBlock() const
+{
+    {
+        LOCK(m_mutex);
+        if (m_pending) return m_pending->hashBlock;
+    }
+    return base->GetBestBlock();
+}
+
+CCoinsViewCursor* CCoinsViewBackgroundWriter::Cursor() const
+{
+    WaitForPending();
+    return base->Cursor();
+}
+
+void CCoinsViewBackgroundWriter::WaitForPending() const
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_pending == nullptr; });
+}
+
+bool CCoinsViewBackgroundWriter::WaitForWrite()
+{
+    WaitForPending();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    LOCK(m_mutex);
+    return !std::exchange(m_write_failed, false);
+}
+
+bool CCoinsViewBackgroundWriter::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase)
+{
+    if (!WaitForWrite()) {
+        return false;
+    }
+    if (erase) {
+        return base->BatchWrite(mapCoins, hashBlock, erase);
+    }
+
+    // The caller keeps its entries, take a copy of the dirty ones and write that in the background
+    auto pending = MakeUnique<PendingWrite>();
+    size_t nCoinsUsage = 0;
+    for (const auto& [outpoint, entry] : mapCoins) {
+        if (!(entry.flags & CCoinsCacheEntry::DIRTY)) {
+            continue;
+        }
+        CCoinsCacheEntry& pendingEntry = pending->coins[outpoint];
+        pendingEntry.coin = entry.coin;
+        pendingEntry.flags = CCoinsCacheEntry::DIRTY;
+        nCoinsUsage += pendingEntry.coin.DynamicMemoryUsage();
+    }
+    pending->hashBlock = hashBlock;
+    m_pending_usage = nCoinsUsage + memusage::DynamicUsage(pending->coins);
+
+    WITH_LOCK(m_mutex, m_pending = std::move(pending));
+    m_thread = std::thread(&TraceThread<std::function<void()>>, "coinswriter", std::function<void()>(std::bind(&CCoinsViewBackgroundWriter::WritePending, this)));
+    return true;
+}
+
+void CCoinsViewBackgroundWriter::WritePending()
+{
+    PendingWrite* pending = WITH_LOCK(m_mutex, return m_pending.get());
+    bool fOk;
+    try {
+        // Leaves the entries in place, readers keep using them until the write is complete
+        fOk = base->BatchWrite(pending->coins, pending->hashBlock, /*erase=*/false);
+    } catch (const std::runtime_error& e) {
+        LogPrintf("%s: Error writing coins: %s\n", __func__, e.what());
+        fOk = false;
+    }
+
+    LOCK(m_mutex);
+    m_pending.reset();
+    m_pending_usage = 0;
+    m_write_failed = !fOk;
+    m_cond.notify_all();
+}
+
 CBlockTreeDB::CBlockTreeDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "blocks" / "index", nCacheSize, fMemory, fWipe) {
 }
 
@@ -11,9 +11,13 @@
 #include <chain.h>
 #include <primitives/block.h>
 #include <spentindex.h>
+#include <sync.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -37,6 +41,8 @@ static const int64_t nMaxBlockDBCache = 2;
 static const int64_t nMaxTxIndexCache = 1024;
 //! Max memory allocated to all block filter index caches combined in MiB.
 static const int64_t max_filter_index_cache = 1024;
+//! Max memory allocated to the block stats index cache in MiB.
+static const int64_t max_blockstats_index_cache = 64;
 //! Max memory allocated to coin DB specific cache (MiB)
 static const int64_t nMaxCoinsDBCache = 8;
 
@@ -56,7 +62,7 @@ public:
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     std::vector<uint256> GetHeadBlocks() const override;
-    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) override;
     CCoinsViewCursor *Cursor() const override;
 
     //! Attempt to update from an older database format. Returns whether an error occurred.
@@ -64,6 +70,51 @@ public:
     size_t EstimateSize() const override;
 };
 
+/**
+ * Coins view between the coins cache and the coin database which writes the coins synced by
+ * CCoinsViewCache::Sync() in a background thread. Until such a write completes, the written coins
+ * are served from a copy kept here, so readers never see the partially updated database.
+ *
+ * BatchWrite calls which hand over their entries (CCoinsViewCache::Flush()) are written synchronously,
+ * as are those following a pending background write, which they wait for first. A failed background
+ * write is reported by the next BatchWrite.
+ */
+class CCoinsViewBackgroundWriter final : public CCoinsViewBacked
+{
+private:
+    struct PendingWrite {
+        CCoinsMapMemoryResource resource{};
+        CCoinsMap coins{0, SaltedOutpointHasher(), CCoinsMap::key_equal{}, &resource};
+        uint256 hashBlock;
+    };
+
+    mutable Mutex m_mutex;
+    mutable std::condition_variable m_cond;
+    //! Not modified while the write is running, so the writer thread reads it without holding m_mutex
+    std::unique_ptr<PendingWrite> m_pending GUARDED_BY(m_mutex);
+    bool m_write_failed GUARDED_BY(m_mutex){false};
+    std::atomic<size_t> m_pending_usage{0};
+    std::thread m_thread;
+
+    void WritePending();
+    void WaitForPending() const;
+
+public:
+    explicit CCoinsViewBackgroundWriter(CCoinsView* view) : CCoinsViewBacked(view) {}
+    ~CCoinsViewBackgroundWriter();
+
+    bool GetCoin(const COutPoint &outpoint, Coin &coin) const override;
+    bool HaveCoin(const COutPoint &outpoint) const override;
+    uint256 GetBestBlock() const override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) override;
+    CCoinsViewCursor *Cursor() const override;
+
+    //! Wait for the pending background write, returns false if it failed
+    bool WaitForWrite();
+    //! Memory held by the copy of the coins being written in the background
+    size_t DynamicMemoryUsage() const { return m_pending_usage; }
+};
+
 /** Specialization of CCoinsViewCursor to iterate over a CCoinsViewDB */
 class CCoinsViewDBCursor: public CCoinsViewCursor
 {
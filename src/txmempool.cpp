@@ -153,6 +153,8 @@ void CTxMemPool::UpdateTransactionsFromBlock(const std::vector<uint256> &vHashes
         } // release epoch guard for UpdateForDescendants
         UpdateForDescendants(it, mapMemPoolDescendantsToUpdate, setAlreadyIncluded);
     }
+    // The links and ancestor/descendant state of the entries changed
+    ++nTransactionsUpdated;
 }
 
 bool CTxMemPool::CalculateMemPoolAncestors(const CTxMemPoolEntry &entry, setEntries &setAncestors, uint64_t limitAncestorCount, uint64_t limitAncestorSize, uint64_t limitDescendantCount, uint64_t limitDescendantSize, std::string &errString, bool fSearchForParents /* = true */) const
@@ -1219,6 +1221,42 @@ std::vector<TxMempoolInfo> CTxMemPool::infoAll() const
     return ret;
 }
 
+std::shared_ptr<const CTxMemPoolSnapshot> CTxMemPool::GetSnapshot() const
+{
+    std::shared_ptr<const CTxMemPoolSnapshot> snapshot = std::atomic_load(&m_snapshot);
+    if (snapshot && snapshot->nTransactionsUpdated == nTransactionsUpdated) {
+        return snapshot;
+    }
+
+    // Rebuilding under cs lets only one caller rebuild an outdated snapshot, the others wait and use its result.
+    // Not having a separate lock for this makes it safe to call with cs already held.
+    LOCK(cs);
+    snapshot = std::atomic_load(&m_snapshot);
+    if (snapshot && snapshot->nTransactionsUpdated == nTransactionsUpdated) {
+        return snapshot;
+    }
+
+    auto new_snapshot = std::make_shared<CTxMemPoolSnapshot>(nTransactionsUpdated);
+    auto iters = GetSortedDepthAndScore();
+    new_snapshot->vEntries.reserve(iters.size());
+    new_snapshot->mapIndex.reserve(iters.size());
+    for (auto it : iters) {
+        std::vector<uint256> vParents;
+        for (const txiter& parent : GetMemPoolParents(it)) {
+            vParents.push_back(parent->GetTx().GetHash());
+        }
+        std::vector<uint256> vChildren;
+        for (const txiter& child : GetMemPoolChildren(it)) {
+            vChildren.push_back(child->GetTx().GetHash());
+        }
+        new_snapshot->mapIndex.emplace(it->GetTx().GetHash(), new_snapshot->vEntries.size());
+        new_snapshot->vEntries.push_back(CTxMemPoolSnapshotEntry{*it, std::move(vParents), std::move(vChildren)});
+    }
+    snapshot = std::move(new_snapshot);
+    std::atomic_store(&m_snapshot, snapshot);
+    return snapshot;
+}
+
 CTransactionRef CTxMemPool::get(const uint256& hash) const
 {
     LOCK(cs);
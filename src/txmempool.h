@@ -6,8 +6,11 @@
 #ifndef BITCOIN_TXMEMPOOL_H
 #define BITCOIN_TXMEMPOOL_H
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 #include <string>
@@ -23,6 +26,7 @@
 #include <primitives/transaction.h>
 #include <sync.h>
 #include <random.h>
+#include <saltedhasher.h>
 #include <netaddress.h>
 #include <pubkey.h>
 
@@ -348,6 +352,34 @@ struct TxMempoolInfo
     int64_t nFeeDelta;
 };
 
+/** Copy of a mempool entry and the txids of its in-mempool parents and children */
+struct CTxMemPoolSnapshotEntry
+{
+    CTxMemPoolEntry entry;
+    std::vector<uint256> vParents;
+    std::vector<uint256> vChildren; //!< sorted by txid
+};
+
+/**
+ * Immutable copy of the whole mempool, see CTxMemPool::GetSnapshot(). It can be used without holding
+ * CTxMemPool::cs, e.g. by RPCs building large replies. Entries are sorted like CTxMemPool::queryHashes().
+ */
+struct CTxMemPoolSnapshot
+{
+    explicit CTxMemPoolSnapshot(unsigned int nTransactionsUpdatedIn) : nTransactionsUpdated(nTransactionsUpdatedIn) {}
+
+    //! Value of CTxMemPool::GetTransactionsUpdated() when the snapshot was taken
+    const unsigned int nTransactionsUpdated;
+    std::vector<CTxMemPoolSnapshotEntry> vEntries;
+    std::unordered_map<uint256, size_t, StaticSaltedHasher> mapIndex;
+
+    const CTxMemPoolSnapshotEntry* Find(const uint256& hash) const
+    {
+        auto it = mapIndex.find(hash);
+        return it == mapIndex.end() ? nullptr : &vEntries[it->second];
+    }
+};
+
 /** Reason why a transaction was removed from the mempool,
  * this is passed to the notification signal.
  */
@@ -449,7 +481,7 @@ class CTxMemPool
 {
 private:
     uint32_t nCheckFrequency GUARDED_BY(cs); //!< Value n means that n times in 2^32 we check.
-    unsigned int nTransactionsUpdated; //!< Used by getblocktemplate to trigger CreateNewBlock() invocation
+    std::atomic<unsigned int> nTransactionsUpdated; //!< Used by getblocktemplate to trigger CreateNewBlock() invocation
     CBlockPolicyEstimator* minerPolicyEstimator;
 
     uint64_t totalTxSize;      //!< sum of all mempool tx' byte sizes
@@ -465,6 +497,10 @@ private:
 
     bool m_is_loaded GUARDED_BY(cs){false};
 
+    //! Last snapshot handed out by GetSnapshot(), only accessed through std::atomic_load/std::atomic_store.
+    //! Rebuilt under cs.
+    mutable std::shared_ptr<const CTxMemPoolSnapshot> m_snapshot;
+
 public:
 
     static const int ROLLING_FEE_HALFLIFE = 60 * 60 * 12; // public only for testing
@@ -743,6 +779,14 @@ public:
     TxMempoolInfo info(const uint256& hash) const;
     std::vector<TxMempoolInfo> infoAll() const;
 
+    /**
+     * Return a snapshot of the current mempool contents. The snapshot is shared between callers and only
+     * rebuilt (under cs) after the mempool has changed, so that frequently polling readers don't contend
+     * on cs with transaction acceptance and block connection. Rebuilding copies the whole mempool, so this
+     * is meant for dumping the whole mempool, single entries are cheaper to look up directly under cs.
+     */
+    std::shared_ptr<const CTxMemPoolSnapshot> GetSnapshot() const;
+
     bool existsProviderTxConflict(const CTransaction &tx) const;
 
     size_t DynamicMemoryUsage() const;
@@ -27,6 +27,8 @@
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <reverse_iterator.h>
+#include <rpc/statuscache.h>
+#include <saltedhasher.h>
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <shutdown.h>
@@ -57,6 +59,7 @@
 #include <statsd_client.h>
 
 #include <string>
+#include <unordered_set>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/thread.hpp> // Required for boost::this_thread::interruption_point();
@@ -1135,11 +1138,12 @@ CoinsViews::CoinsViews(
     bool in_memory,
     bool should_wipe) : m_dbview(
                             GetDataDir() / ldb_name, cache_size_bytes, in_memory, should_wipe),
-                        m_catcherview(&m_dbview) {}
+                        m_catcherview(&m_dbview),
+                        m_writerview(&m_catcherview) {}
 
 void CoinsViews::InitCache()
 {
-    m_cacheview = MakeUnique<CCoinsViewCache>(&m_catcherview);
+    m_cacheview = MakeUnique<CCoinsViewCache>(&m_writerview);
 }
 
 // NOTE: for now m_blockman is set to a global, but this will be changed
@@ -1846,14 +1850,99 @@ static bool WriteUndoDataForBlock(const CBlockUndo& blockundo, CValidationState&
 
 static CCheckQueue<CScriptCheck> scriptcheckqueue(128);
 
+/** Reads a coin from the coins database, used to fetch the inputs of a block in parallel */
+class CCoinPrefetch
+{
+private:
+    const CCoinsView* m_db{nullptr};
+    COutPoint m_outpoint;
+    Coin* m_coin{nullptr};
+
+public:
+    CCoinPrefetch() = default;
+    CCoinPrefetch(const CCoinsView& db, const COutPoint& outpoint, Coin& coin) :
+        m_db(&db), m_outpoint(outpoint), m_coin(&coin) {}
+
+    bool operator()()
+    {
+        try {
+            m_db->GetCoin(m_outpoint, *m_coin);
+        } catch (const std::runtime_error&) {
+            // leave the coin to be read (and the error to be handled) when the block is connected
+            *m_coin = Coin();
+        }
+        return true;
+    }
+
+    void swap(CCoinPrefetch& check)
+    {
+        std::swap(m_db, check.m_db);
+        std::swap(m_outpoint, check.m_outpoint);
+        std::swap(m_coin, check.m_coin);
+    }
+};
+
+static CCheckQueue<CCoinPrefetch> coinprefetchqueue(16);
+
 void StartScriptCheckWorkerThreads(int threads_num)
 {
     scriptcheckqueue.StartWorkerThreads(threads_num);
+    coinprefetchqueue.StartWorkerThreads(threads_num);
 }
 
 void StopScriptCheckWorkerThreads()
 {
     scriptcheckqueue.StopWorkerThreads();
+    coinprefetchqueue.StopWorkerThreads();
+}
+
+/**
+ * Read the coins spent by a block which are neither created in the block nor in the coins cache yet from the
+ * database, using the worker threads. Connecting the block then finds all of its inputs in the cache instead of
+ * doing one synchronous database read after the other. Returns the number of coins added to the cache.
+ */
+static size_t PrefetchBlockInputs(const CBlock& block, CCoinsViewCache& cache, const CCoinsView& db, size_t& nMissing)
+{
+    std::unordered_set<uint256, StaticSaltedHasher> blockTxids;
+    blockTxids.reserve(block.vtx.size());
+    for (const auto& tx : block.vtx) {
+        blockTxids.emplace(tx->GetHash());
+    }
+
+    std::vector<COutPoint> outpoints;
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase()) continue;
+        for (const CTxIn& txin : tx->vin) {
+            if (!blockTxids.count(txin.prevout.hash) && !cache.HaveCoinInCache(txin.prevout)) {
+                outpoints.emplace_back(txin.prevout);
+            }
+        }
+    }
+    nMissing = outpoints.size();
+    if (outpoints.empty()) {
+        return 0;
+    }
+
+    std::vector<Coin> coins(outpoints.size());
+    {
+        CCheckQueueControl<CCoinPrefetch> control(&coinprefetchqueue);
+        std::vector<CCoinPrefetch> vFetches;
+        vFetches.reserve(outpoints.size());
+        for (size_t i = 0; i < outpoints.size(); i++) {
+            vFetches.emplace_back(db, outpoints[i], coins[i]);
+        }
+        control.Add(vFetches);
+        control.Wait();
+    }
+
+    size_t nFetched = 0;
+    for (size_t i = 0; i < outpoints.size(); i++) {
+        // missing coins are left for connecting the block to fail on
+        if (!coins[i].IsSpent() && cache.EmplaceCoinFromBase(outpoints[i], std::move(coins[i]))) {
+            nFetched++;
+        }
+    }
+    return nFetched;
 }
 
 VersionBitsCache versionbitscache GUARDED_BY(cs_main);
@@ -1961,6 +2050,7 @@ static int64_t nTimeSubsidy = 0;
 static int64_t nTimeValueValid = 0;
 static int64_t nTimePayeeValid = 0;
 static int64_t nTimeProcessSpecial = 0;
+static int64_t nTimePrefetch = 0;
 static int64_t nTimeDashSpecific = 0;
 static int64_t nTimeConnect = 0;
 static int64_t nTimeIndex = 0;
@@ -2119,6 +2209,15 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     int64_t nTime2 = GetTimeMicros(); nTimeForks += nTime2 - nTime1;
     LogPrint(BCLog::BENCHMARK, "    - Fork checks: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime2 - nTime1), nTimeForks * MICRO, nTimeForks * MILLI / nBlocksTotal);
 
+    if (g_parallel_script_checks) {
+        // Without this, every input missing in the coins cache costs a synchronous database read while connecting
+        size_t nMissing;
+        size_t nFetched = PrefetchBlockInputs(block, CoinsTip(), CoinsBackgroundWriter(), nMissing);
+        int64_t nTime2_0 = GetTimeMicros(); nTimePrefetch += nTime2_0 - nTime2;
+        LogPrint(BCLog::BENCHMARK, "      - Prefetch %u of %u inputs missing in cache: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)nFetched, (unsigned)nMissing,
+                 MILLI * (nTime2_0 - nTime2), nMissing == 0 ? 0 : MILLI * (nTime2_0 - nTime2) / nMissing, nTimePrefetch * MICRO, nTimePrefetch * MILLI / nBlocksTotal);
+    }
+
     CBlockUndo blockundo;
 
     // Precomputed transaction data pointers must not be invalidated
@@ -2414,22 +2513,34 @@ CoinsCacheSizeState CChainState::GetCoinsCacheSizeState(const CTxMemPool& tx_poo
         gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000);
 }
 
-CoinsCacheSizeState CChainState::GetCoinsCacheSizeState(
+//! Total memory the coins cache may use, and the soft (LARGE) threshold below it.
+static std::pair<int64_t, int64_t> GetCoinsCacheLimits(
     const CTxMemPool& tx_pool,
     size_t max_coins_cache_size_bytes,
     size_t max_mempool_size_bytes)
 {
     int64_t nMempoolUsage = tx_pool.DynamicMemoryUsage();
-    int64_t cacheSize = CoinsTip().DynamicMemoryUsage();
     int64_t nTotalSpace =
         max_coins_cache_size_bytes + std::max<int64_t>(max_mempool_size_bytes - nMempoolUsage, 0);
 
-    cacheSize += evoDb->GetMemoryUsage();
-
     //! No need to periodic flush if at least this much space still available.
     static constexpr int64_t MAX_BLOCK_COINSDB_USAGE_BYTES = 10 * 1024 * 1024;  // 10MB
     int64_t large_threshold =
         std::max((9 * nTotalSpace) / 10, nTotalSpace - MAX_BLOCK_COINSDB_USAGE_BYTES);
+    return {nTotalSpace, large_threshold};
+}
+
+CoinsCacheSizeState CChainState::GetCoinsCacheSizeState(
+    const CTxMemPool& tx_pool,
+    size_t max_coins_cache_size_bytes,
+    size_t max_mempool_size_bytes)
+{
+    int64_t cacheSize = CoinsTip().DynamicMemoryUsage();
+    // The coins still being written in the background are held in memory as well
+    cacheSize += CoinsBackgroundWriter().DynamicMemoryUsage();
+    cacheSize += evoDb->GetMemoryUsage();
+
+    const auto [nTotalSpace, large_threshold] = GetCoinsCacheLimits(tx_pool, max_coins_cache_size_bytes, max_mempool_size_bytes);
 
     if (cacheSize > nTotalSpace) {
         LogPrintf("Cache size (%s) exceeds total space (%s)\n", cacheSize, nTotalSpace);
@@ -2440,6 +2551,24 @@ CoinsCacheSizeState CChainState::GetCoinsCacheSizeState(
     return CoinsCacheSizeState::OK;
 }
 
+size_t CChainState::GetCoinsTipSoftLimit(const CTxMemPool& tx_pool)
+{
+    return this->GetCoinsTipSoftLimit(
+        tx_pool,
+        nCoinCacheUsage,
+        gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000);
+}
+
+size_t CChainState::GetCoinsTipSoftLimit(
+    const CTxMemPool& tx_pool,
+    size_t max_coins_cache_size_bytes,
+    size_t max_mempool_size_bytes)
+{
+    // The coins being written in the background are not counted, they are released once the write is done.
+    const int64_t large_threshold = GetCoinsCacheLimits(tx_pool, max_coins_cache_size_bytes, max_mempool_size_bytes).second;
+    return std::max<int64_t>(large_threshold - evoDb->GetMemoryUsage(), 0);
+}
+
 bool CChainState::FlushStateToDisk(
     const CChainParams& chainparams,
     CValidationState &state,
@@ -2475,6 +2604,11 @@ bool CChainState::FlushStateToDisk(
             }
             if (!setFilesToPrune.empty()) {
                 fFlushForPrune = true;
+                // The pruned files' blocks no longer have data, which changes the prune height reported by
+                // getblockchaininfo
+                if (g_rpc_status_cache) {
+                    g_rpc_status_cache->SetDirty();
+                }
                 if (!fHavePruned) {
                     pblocktree->WriteFlag("prunedblockfiles", true);
                     fHavePruned = true;
@@ -2497,10 +2631,14 @@ bool CChainState::FlushStateToDisk(
         bool fPeriodicWrite = mode == FlushStateMode::PERIODIC && nNow > nLastWrite + DATABASE_WRITE_INTERVAL;
         // It's been very long since we flushed the cache. Do this infrequently, to optimize cache usage.
         bool fPeriodicFlush = mode == FlushStateMode::PERIODIC && nNow > nLastFlush + DATABASE_FLUSH_INTERVAL;
-        // Combine all conditions that result in a full cache flush.
-        fDoFullFlush = (mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicFlush || fFlushForPrune;
+        // Combine all conditions that result in a full cache flush, which also empties the cache.
+        fDoFullFlush = (mode == FlushStateMode::ALWAYS) || fCacheCritical;
+        // All other conditions only write the dirty coins and keep the (then clean) coins cached. Doing this whenever the
+        // cache gets large and on every periodic write keeps the amount of dirty coins small, so a following full
+        // flush has little left to write and doesn't stall block connection for long.
+        bool fSyncCoins = !fDoFullFlush && (fCacheLarge || fPeriodicWrite || fPeriodicFlush || fFlushForPrune);
         // Write blocks and block index to disk.
-        if (fDoFullFlush || fPeriodicWrite) {
+        if (fDoFullFlush || fSyncCoins) {
             // Depend on nMinDiskSpace to ensure we can write block index
             if (!CheckDiskSpace(GetBlocksDir())) {
                 return AbortNode(state, "Disk space is too low!", _("Disk space is too low!"));
@@ -2542,9 +2680,9 @@ bool CChainState::FlushStateToDisk(
             nLastWrite = nNow;
         }
         // Flush best chain related state. This can only be done if the blocks / block index write was also done.
-        if (fDoFullFlush && !CoinsTip().GetBestBlock().IsNull()) {
-            LOG_TIME_SECONDS(strprintf("write coins cache to disk (%d coins, %.2fkB)",
-                coins_count, coins_mem_usage / 1000));
+        if ((fDoFullFlush || fSyncCoins) && !CoinsTip().GetBestBlock().IsNull()) {
+            LOG_TIME_SECONDS(strprintf("%s coins cache to disk (%d coins, %.2fkB)",
+                fDoFullFlush ? "write" : "sync", coins_count, coins_mem_usage / 1000));
 
             // Typical Coin structures on disk are around 48 bytes in size.
             // Pushing a new one to the database can cause it to be written
@@ -2554,9 +2692,23 @@ bool CChainState::FlushStateToDisk(
             if (!CheckDiskSpace(GetDataDir(), 48 * 2 * 2 * CoinsTip().GetCacheSize())) {
                 return AbortNode(state, "Disk space is too low!", _("Disk space is too low!"));
             }
-            // Flush the chainstate (which may refer to block index entries).
-            if (!CoinsTip().Flush())
-                return AbortNode(state, "Failed to write to coin database");
+            if (fDoFullFlush) {
+                // Flush the chainstate (which may refer to block index entries).
+                if (!CoinsTip().Flush())
+                    return AbortNode(state, "Failed to write to coin database");
+                // Give the memory of the coins cache back, otherwise it keeps counting towards -dbcache
+                CoinsTip().ReallocateCache();
+            } else {
+                // Write the dirty coins only, the cache stays warm. The write itself happens in the background
+                // (see CCoinsViewBackgroundWriter) and the next flush waits for it, reporting a failure.
+                if (!CoinsTip().Sync())
+                    return AbortNode(state, "Failed to write to coin database");
+                if (fCacheLarge) {
+                    // All coins are clean now, drop enough of them to get back under the soft threshold, so the
+                    // cache doesn't keep growing until it is CRITICAL and gets wiped by a full flush.
+                    CoinsTip().EvictClean(GetCoinsTipSoftLimit(::mempool));
+                }
+            }
             if (!evoDb->CommitRootTransaction()) {
                 return AbortNode(state, "Failed to commit EvoDB");
             }
@@ -5261,6 +5413,42 @@ int VersionBitsTipStateSinceHeight(const Consensus::Params& params, Consensus::D
 }
 
 static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+/** Number of transactions from mempool.dat which are verified and added to the mempool at once */
+static const size_t MEMPOOL_LOAD_BATCH_SIZE = 500;
+
+/**
+ * Verify the scripts of a batch of transactions loaded from mempool.dat on the script check threads, without
+ * holding cs_main while the signatures are checked. This only fills the signature cache: accepting the
+ * transactions to the mempool afterwards runs all checks again, but finds the signatures already verified.
+ * The transactions are expected in dependency order, as written by DumpMempool.
+ */
+static void PreVerifyMempoolScripts(const CTxMemPool& pool, const std::vector<CTransactionRef>& txs)
+{
+    std::vector<PrecomputedTransactionData> txdata(txs.size());
+    std::vector<CScriptCheck> vChecks;
+    {
+        LOCK2(cs_main, pool.cs);
+        CCoinsViewMemPool viewMemPool(&::ChainstateActive().CoinsTip(), pool);
+        CCoinsViewCache view(&viewMemPool);
+        for (size_t i = 0; i < txs.size(); i++) {
+            const CTransaction& tx = *txs[i];
+            if (tx.IsCoinBase() || !view.HaveInputs(tx)) {
+                continue;
+            }
+            CValidationState state;
+            std::vector<CScriptCheck> vTxChecks;
+            if (CheckInputs(tx, state, view, true, STANDARD_SCRIPT_VERIFY_FLAGS, true, false, txdata[i], &vTxChecks)) {
+                std::move(vTxChecks.begin(), vTxChecks.end(), std::back_inserter(vChecks));
+            }
+            // Make the outputs available to the children of this transaction in the same batch
+            AddCoins(view, tx, MEMPOOL_HEIGHT, true);
+        }
+    }
+
+    CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+    control.Add(vChecks);
+    control.Wait();
+}
 
 bool LoadMempool(CTxMemPool& pool)
 {
@@ -5279,6 +5467,50 @@ bool LoadMempool(CTxMemPool& pool)
     int64_t already_there = 0;
     int64_t nNow = GetTime();
 
+    std::vector<CTransactionRef> batch_txs;
+    std::vector<int64_t> batch_times;
+    batch_txs.reserve(MEMPOOL_LOAD_BATCH_SIZE);
+    batch_times.reserve(MEMPOOL_LOAD_BATCH_SIZE);
+
+    // Verify the scripts of the batch in parallel, then add the transactions to the mempool in
+    // file (i.e. dependency) order, taking cs_main once per batch instead of once per transaction.
+    auto accept_batch = [&]() {
+        try {
+            if (g_parallel_script_checks) {
+                PreVerifyMempoolScripts(pool, batch_txs);
+            }
+            LOCK(cs_main);
+            for (size_t i = 0; i < batch_txs.size(); i++) {
+                const CTransactionRef& tx = batch_txs[i];
+                CValidationState state;
+                AcceptToMemoryPoolWithTime(chainparams, pool, state, tx, nullptr /* pfMissingInputs */, batch_times[i],
+                                           false /* bypass_limits */, 0 /* nAbsurdFee */, false /* test_accept */);
+                if (state.IsValid()) {
+                    ++count;
+                } else {
+                    // mempool may contain the transaction already, e.g. from
+                    // wallet(s) having loaded it while we were processing
+                    // mempool transactions; consider these as valid, instead of
+                    // failed, but mark them as 'already there'
+                    if (pool.exists(tx->GetHash())) {
+                        ++already_there;
+                    } else {
+                        ++failed;
+                    }
+                }
+            }
+        } catch (...) {
+            // Loading stops at the entry that threw, like it did when each transaction was added right after reading
+            // it. Drop the rest of the batch, so the handler below doesn't add the same batch again.
+            ++failed;
+            batch_txs.clear();
+            batch_times.clear();
+            throw;
+        }
+        batch_txs.clear();
+        batch_times.clear();
+    };
+
     try {
         uint64_t version;
         file >> version;
@@ -5300,27 +5532,15 @@ bool LoadMempool(CTxMemPool& pool)
             if (amountdelta) {
                 pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
             }
-            CValidationState state;
             if (nTime + nExpiryTimeout > nNow) {
-                LOCK(cs_main);
-                AcceptToMemoryPoolWithTime(chainparams, pool, state, tx, nullptr /* pfMissingInputs */, nTime,
-                                           false /* bypass_limits */, 0 /* nAbsurdFee */, false /* test_accept */);
-                if (state.IsValid()) {
-                    ++count;
-                } else {
-                    // mempool may contain the transaction already, e.g. from
-                    // wallet(s) having loaded it while we were processing
-                    // mempool transactions; consider these as valid, instead of
-                    // failed, but mark them as 'already there'
-                    if (pool.exists(tx->GetHash())) {
-                        ++already_there;
-                    } else {
-                        ++failed;
-                    }
-                }
+                batch_txs.push_back(std::move(tx));
+                batch_times.push_back(nTime);
             } else {
                 ++expired;
             }
+            if (batch_txs.size() >= MEMPOOL_LOAD_BATCH_SIZE || (num == 0 && !batch_txs.empty())) {
+                accept_batch();
+            }
             if (ShutdownRequested())
                 return false;
         }
@@ -5332,6 +5552,8 @@ bool LoadMempool(CTxMemPool& pool)
         }
     } catch (const std::exception& e) {
         LogPrintf("Failed to deserialize mempool data on disk: %s. Continuing anyway.\n", e.what());
+        // Still add the transactions read before the error
+        accept_batch();
         return false;
     }
 
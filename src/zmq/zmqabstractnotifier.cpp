@@ -4,21 +4,47 @@
 
 #include <zmq/zmqabstractnotifier.h>
 
+#include <chainparams.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <validation.h>
+#include <version.h>
+#include <zmq/zmqutil.h>
+
 #include <cassert>
 
 const int CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM;
 
+const std::vector<unsigned char>* CZMQBlockData::GetSerializedBlock()
+{
+    if (!m_serialized && !m_failed) {
+        CBlock block_from_disk;
+        if (!m_block) {
+            LOCK(cs_main);
+            if (!ReadBlockFromDisk(block_from_disk, m_pindex, Params().GetConsensus())) {
+                zmqError("Can't read block from disk");
+                m_failed = true;
+                return nullptr;
+            }
+        }
+        CVectorWriter writer(SER_NETWORK, PROTOCOL_VERSION, m_data, 0);
+        writer << (m_block ? *m_block : block_from_disk);
+        m_serialized = true;
+    }
+    return m_failed ? nullptr : &m_data;
+}
+
 CZMQAbstractNotifier::~CZMQAbstractNotifier()
 {
     assert(!psocket);
 }
 
-bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/)
+bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/, CZMQBlockData & /*block*/)
 {
     return true;
 }
 
-bool CZMQAbstractNotifier::NotifyChainLock(const CBlockIndex * /*CBlockIndex*/, const std::shared_ptr<const llmq::CChainLockSig> & /*clsig*/)
+bool CZMQAbstractNotifier::NotifyChainLock(const CBlockIndex * /*CBlockIndex*/, const std::shared_ptr<const llmq::CChainLockSig> & /*clsig*/, CZMQBlockData & /*block*/)
 {
     return true;
 }
@@ -7,9 +7,12 @@
 
 #include <util/memory.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
+class CBlock;
 class CBlockIndex;
 class CGovernanceObject;
 class CGovernanceVote;
@@ -26,6 +29,27 @@ namespace llmq {
 
 using CZMQNotifierFactory = std::unique_ptr<CZMQAbstractNotifier> (*)();
 
+/**
+ * A block passed to the block notifiers. It is serialized only once, when the first notifier asks for it, and
+ * all raw notifiers then send the same bytes. Blocks which were just connected are passed in from memory, other
+ * blocks (and blocks which are no longer at hand) are read from disk.
+ */
+class CZMQBlockData
+{
+public:
+    CZMQBlockData(const CBlockIndex* pindex, std::shared_ptr<const CBlock> block) : m_pindex(pindex), m_block(std::move(block)) {}
+
+    //! The serialized block, or nullptr if it couldn't be read from disk
+    const std::vector<unsigned char>* GetSerializedBlock();
+
+private:
+    const CBlockIndex* m_pindex;
+    std::shared_ptr<const CBlock> m_block;
+    bool m_serialized{false};
+    bool m_failed{false};
+    std::vector<unsigned char> m_data;
+};
+
 class CZMQAbstractNotifier
 {
 public:
@@ -54,8 +78,10 @@ public:
     virtual bool Initialize(void *pcontext) = 0;
     virtual void Shutdown() = 0;
 
-    virtual bool NotifyBlock(const CBlockIndex *pindex);
-    virtual bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig);
+    uint64_t GetMessagesSent() const { return m_messages_sent; }
+
+    virtual bool NotifyBlock(const CBlockIndex *pindex, CZMQBlockData& block);
+    virtual bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig, CZMQBlockData& block);
     virtual bool NotifyTransaction(const CTransaction &transaction);
     virtual bool NotifyTransactionLock(const CTransactionRef& transaction, const std::shared_ptr<const llmq::CInstantSendLock>& islock);
     virtual bool NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote);
@@ -68,6 +94,7 @@ protected:
     std::string type;
     std::string address;
     int outbound_message_high_water_mark; // aka SNDHWM
+    std::atomic<uint64_t> m_messages_sent{0};
 };
 
 #endif // BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
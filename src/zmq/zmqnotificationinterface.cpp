@@ -142,20 +142,28 @@ void TryForEachAndRemoveFailed(std::list<std::unique_ptr<CZMQAbstractNotifier>>&
 }
 }
 
+std::shared_ptr<const CBlock> CZMQNotificationInterface::GetConnectedBlock(const CBlockIndex* pindex)
+{
+    LOCK(cs_last_block);
+    return m_last_block_index == pindex ? m_last_block : nullptr;
+}
+
 void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload)
 {
     if (fInitialDownload || pindexNew == pindexFork) // In IBD or blocks were disconnected without any new ones
         return;
 
-    TryForEachAndRemoveFailed(notifiers, [pindexNew](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyBlock(pindexNew);
+    CZMQBlockData block(pindexNew, GetConnectedBlock(pindexNew));
+    TryForEachAndRemoveFailed(notifiers, [pindexNew, &block](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyBlock(pindexNew, block);
     });
 }
 
 void CZMQNotificationInterface::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
 {
-    TryForEachAndRemoveFailed(notifiers, [pindex, &clsig](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyChainLock(pindex, clsig);
+    CZMQBlockData block(pindex, GetConnectedBlock(pindex));
+    TryForEachAndRemoveFailed(notifiers, [pindex, &clsig, &block](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyChainLock(pindex, clsig, block);
     });
 }
 
@@ -172,6 +180,12 @@ void CZMQNotificationInterface::TransactionAddedToMempool(const CTransactionRef&
 
 void CZMQNotificationInterface::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected, const std::vector<CTransactionRef>& vtxConflicted)
 {
+    {
+        LOCK(cs_last_block);
+        m_last_block_index = pindexConnected;
+        m_last_block = pblock;
+    }
+
     for (const CTransactionRef& ptx : pblock->vtx) {
         // Do a normal notify for each transaction added in the block
         TransactionAddedToMempool(ptx, 0);
@@ -5,6 +5,7 @@
 #ifndef BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 #define BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 
+#include <sync.h>
 #include <validationinterface.h>
 #include <list>
 #include <memory>
@@ -40,8 +41,15 @@ protected:
 private:
     CZMQNotificationInterface();
 
+    /** The block connected last, if it is pindex, so that block notifiers don't need to read it from disk again */
+    std::shared_ptr<const CBlock> GetConnectedBlock(const CBlockIndex* pindex);
+
     void *pcontext;
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
+
+    Mutex cs_last_block;
+    const CBlockIndex* m_last_block_index GUARDED_BY(cs_last_block){nullptr};
+    std::shared_ptr<const CBlock> m_last_block GUARDED_BY(cs_last_block);
 };
 
 extern CZMQNotificationInterface* g_zmq_notification_interface;
@@ -28,6 +28,8 @@ UniValue getzmqnotifications(const JSONRPCRequest& request)
                             {RPCResult::Type::STR, "type", "Type of notification"},
                             {RPCResult::Type::STR, "address", "Address of the publisher"},
                             {RPCResult::Type::NUM, "hwm", "Outbound message high water mark"},
+                            {RPCResult::Type::NUM, "sent", "Number of messages sent. Messages for subscribers which reached the high water mark\n"
+                                "are dropped by ZeroMQ itself, subscribers can detect those from gaps in the message sequence numbers"},
                         }},
                     }
                 },
@@ -45,6 +47,7 @@ UniValue getzmqnotifications(const JSONRPCRequest& request)
             obj.pushKV("type", n->GetType());
             obj.pushKV("address", n->GetAddress());
             obj.pushKV("hwm", n->GetOutboundMessageHighWaterMark());
+            obj.pushKV("sent", n->GetMessagesSent());
             result.push_back(obj);
         }
     }
@@ -52,6 +52,13 @@ class LLMQChainLocksTest(DashTestFramework):
             block = self.nodes[0].getblock(self.nodes[0].getblockhash(h))
             assert block['chainlock']
 
+        self.log.info("Check chainlock stats")
+        for mn in self.mninfo:
+            stats = mn.node.getchainlockstats()
+            assert stats['sign_requests'] > 0
+            assert stats['chainlocks_processed'] > 0
+            assert stats['sign_attempts'] >= stats['sign_requests']
+
         self.log.info("Isolate node, mine on another, and reconnect")
         isolate_node(self.nodes[0])
         node0_mining_addr = self.nodes[0].getnewaddress()
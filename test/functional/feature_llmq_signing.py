@@ -108,6 +108,11 @@ class LLMQSigningTest(DashTestFramework):
         if self.options.spork21:
             mn.node.disconnect_p2ps()
 
+        # Sig share state stats must be consistent, every session is known by at least one node
+        stats = self.mninfo[0].node.quorum("sigsharesstats")
+        assert_equal(stats["memoryUsage"]["total"], stats["memoryUsage"]["sigShares"] + stats["memoryUsage"]["nodeStates"] + stats["memoryUsage"]["sessions"])
+        assert stats["nodeSessions"] >= stats["sessions"]
+
         # Test `quorum verify` rpc
         node = self.mninfo[0].node
         recsig = node.quorum("getrecsig", 104, id, msgHash)
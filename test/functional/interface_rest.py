@@ -20,6 +20,7 @@ from test_framework.util import (
     assert_greater_than,
     assert_greater_than_or_equal,
     hex_str_to_bytes,
+    p2p_port,
 )
 
 class ReqType(Enum):
@@ -41,7 +42,7 @@ class RESTTest (BitcoinTestFramework):
     def set_test_params(self):
         self.setup_clean_chain = True
         self.num_nodes = 2
-        self.extra_args = [["-rest"], []]
+        self.extra_args = [["-rest", "-addressindex", "-spentindex"], []]
 
     def skip_test_if_missing_module(self):
         self.skip_if_no_wallet()
@@ -322,5 +323,53 @@ class RESTTest (BitcoinTestFramework):
         json_obj = self.test_rest_request("/chaininfo")
         assert_equal(json_obj['bestblockhash'], bb_hash)
 
+        self.log.info("Test the /addressutxos and /addressdeltas URIs")
+
+        for uri, rpc in (("/addressutxos", self.nodes[0].getaddressutxos), ("/addressdeltas", self.nodes[0].getaddressdeltas)):
+            json_obj = self.test_rest_request("{}/{}".format(uri, not_related_address))
+            assert_equal(json_obj, rpc({"addresses": [not_related_address]}))
+            bin_response = self.test_rest_request("{}/{}".format(uri, not_related_address), req_type=ReqType.BIN, ret_type=RetType.BYTES)
+            hex_response = self.test_rest_request("{}/{}".format(uri, not_related_address), req_type=ReqType.HEX, ret_type=RetType.BYTES)
+            assert_equal(bin_response, bytes.fromhex(hex_response.decode('ascii').strip()))
+            self.test_rest_request("{}/invalid".format(uri), status=400, ret_type=RetType.OBJ)
+
+        self.log.info("Test the /spentinfo URI")
+
+        json_obj = self.test_rest_request("/spentinfo/{}-{}".format(*spent))
+        assert_equal(json_obj['txid'], txid)
+        assert_equal(json_obj, self.nodes[0].getspentinfo({"txid": spent[0], "index": spent[1]}))
+        self.test_rest_request("/spentinfo/{}-{}".format(*spending), status=404, ret_type=RetType.OBJ)
+        self.test_rest_request("/spentinfo/{}".format(txid), status=400, ret_type=RetType.OBJ)
+
+        self.log.info("Test the /protx and /quorum URIs")
+
+        # The collateral needs more than node 0's single mature block reward
+        self.nodes[0].generate(2)
+        self.nodes[1].generatetoaddress(100, not_related_address)
+        self.sync_all()
+        owner_address = self.nodes[0].getnewaddress()
+        operator_key = self.nodes[0].bls('generate')['public']
+        protx_hash = self.nodes[0].protx('register_fund', self.nodes[0].getnewaddress(), '127.0.0.1:{}'.format(p2p_port(self.num_nodes)),
+                                         owner_address, operator_key, owner_address, 0, self.nodes[0].getnewaddress())
+        self.nodes[0].generate(1)
+        self.sync_all()
+
+        json_obj = self.test_rest_request("/protx/{}".format(protx_hash))
+        assert_equal(json_obj['proTxHash'], protx_hash)
+        # protx info adds the collateral confirmations and the meta and wallet info to the masternode itself
+        rpc_obj = self.nodes[0].protx('info', protx_hash)
+        for key in ('confirmations', 'metaInfo', 'wallet'):
+            rpc_obj.pop(key, None)
+        assert_equal(json_obj, rpc_obj)
+        bin_response = self.test_rest_request("/protx/{}".format(protx_hash), req_type=ReqType.BIN, ret_type=RetType.BYTES)
+        hex_response = self.test_rest_request("/protx/{}".format(protx_hash), req_type=ReqType.HEX, ret_type=RetType.BYTES)
+        assert_equal(bin_response, bytes.fromhex(hex_response.decode('ascii').strip()))
+
+        # A mined quorum needs running masternodes, see interface_rest_dash.py
+        self.test_rest_request("/protx/{}".format(txid), status=404, ret_type=RetType.OBJ)
+        self.test_rest_request("/protx/invalid", status=400, ret_type=RetType.OBJ)
+        self.test_rest_request("/quorum/100/{}".format(bb_hash), status=404, ret_type=RetType.OBJ)
+        self.test_rest_request("/quorum/255/{}".format(bb_hash), status=400, ret_type=RetType.OBJ)
+
 if __name__ == '__main__':
     RESTTest().main()
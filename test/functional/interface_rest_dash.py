@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Dash Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+'''
+interface_rest_dash.py
+
+Test the REST URIs which need masternodes and quorums (/protx and /quorum) against their RPC equivalents
+
+'''
+
+from decimal import Decimal
+import http.client
+import json
+import urllib.parse
+
+from test_framework.test_framework import DashTestFramework
+from test_framework.util import assert_equal
+
+
+class RESTDashTest(DashTestFramework):
+    def set_test_params(self):
+        self.set_dash_test_params(4, 3, [["-rest"], [], [], []], fast_dip3_enforcement=True)
+
+    def test_rest_request(self, uri, status=200):
+        conn = http.client.HTTPConnection(self.url.hostname, self.url.port)
+        conn.request('GET', '/rest' + uri + '.json')
+        resp = conn.getresponse()
+        assert_equal(resp.status, status)
+        if status != 200:
+            return resp
+        return json.loads(resp.read().decode('utf-8'), parse_float=Decimal)
+
+    def run_test(self):
+        self.url = urllib.parse.urlparse(self.nodes[0].url)
+        node = self.nodes[0]
+
+        self.log.info("Test the /protx URI")
+
+        for mn in self.mninfo:
+            json_obj = self.test_rest_request("/protx/{}".format(mn.proTxHash))
+            assert_equal(json_obj['proTxHash'], mn.proTxHash)
+            # protx info adds the collateral confirmations and the meta and wallet info to the masternode itself
+            rpc_obj = node.protx('info', mn.proTxHash)
+            for key in ('confirmations', 'metaInfo', 'wallet'):
+                rpc_obj.pop(key, None)
+            assert_equal(json_obj, rpc_obj)
+
+        self.log.info("Test the /quorum URI")
+
+        node.spork("SPORK_17_QUORUM_DKG_ENABLED", 0)
+        self.wait_for_sporks_same()
+        quorum_hash = self.mine_quorum()
+        assert quorum_hash in node.quorum('list')['llmq_test']
+
+        json_obj = self.test_rest_request("/quorum/100/{}".format(quorum_hash))
+        quorum_info = node.quorum('info', 100, quorum_hash)
+        assert_equal(json_obj['llmqType'], 100)
+        assert_equal(json_obj['quorumHash'], quorum_hash)
+        assert_equal(json_obj['quorumIndex'], quorum_info['quorumIndex'])
+        assert_equal(json_obj['minedBlock'], quorum_info['minedBlock'])
+        assert_equal(json_obj['quorumPublicKey'], quorum_info['quorumPublicKey'])
+        assert_equal(json_obj['validMembersCount'], len([m for m in quorum_info['members'] if m['valid']]))
+
+        # Quorums are keyed by their type as well
+        self.test_rest_request("/quorum/104/{}".format(quorum_hash), status=404)
+
+
+if __name__ == '__main__':
+    RESTDashTest().main()
@@ -5,9 +5,10 @@
 """Tests some generic aspects of the RPC interface."""
 
 import os
+import threading
 from test_framework.authproxy import JSONRPCException
 from test_framework.test_framework import BitcoinTestFramework
-from test_framework.util import assert_equal, assert_greater_than_or_equal
+from test_framework.util import assert_equal, assert_greater_than_or_equal, assert_raises_rpc_error, get_rpc_proxy, wait_until
 
 def expect_http_status(expected_http_status, expected_rpc_code,
                        fcn, *args):
@@ -18,6 +19,16 @@ def expect_http_status(expected_http_status, expected_rpc_code,
         assert_equal(exc.error["code"], expected_rpc_code)
         assert_equal(exc.http_status, expected_http_status)
 
+class WaitForNewBlockThread(threading.Thread):
+    def __init__(self, node):
+        threading.Thread.__init__(self)
+        # The thread needs its own connection to the node
+        self.node = get_rpc_proxy(node.url, 1, timeout=600, coveragedir=node.coverage_dir)
+        self.result = None
+
+    def run(self):
+        self.result = self.node.waitfornewblock(60000)
+
 class RPCInterfaceTest(BitcoinTestFramework):
     def set_test_params(self):
         self.num_nodes = 1
@@ -60,16 +71,115 @@ class RPCInterfaceTest(BitcoinTestFramework):
         assert_equal(result_by_id[3]['error'], None)
         assert result_by_id[3]['result'] is not None
 
+    def test_parallel_batch_request(self):
+        self.log.info("Testing JSON-RPC batch request executed in parallel...")
+
+        node = self.nodes[0]
+        node.generatetoaddress(20, node.get_deterministic_priv_key().address)
+        hashes = [node.getblockhash(height) for height in range(21)]
+        tip = hashes[-1]
+
+        # Lookups may run in parallel, but exclusive calls separate the calls before and after them
+        requests = [{"method": "getblockhash", "id": height, "params": [height]} for height in range(21)]
+        requests.append({"method": "getblockcount", "id": 21})
+        requests.append({"method": "invalidateblock", "id": 22, "params": [tip]})
+        requests += [{"method": "getblockcount", "id": 23 + i} for i in range(5)]
+        requests.append({"method": "reconsiderblock", "id": 28, "params": [tip]})
+        requests += [{"method": "getbestblockhash", "id": 29 + i} for i in range(5)]
+        results = node.batch(requests)
+
+        # Replies are in the order of the requests
+        assert_equal([res["id"] for res in results], list(range(34)))
+        assert all(res["error"] is None for res in results)
+        assert_equal([res["result"] for res in results[:21]], hashes)
+        assert_equal(results[21]["result"], 20)
+        assert_equal([res["result"] for res in results[23:28]], [19] * 5)
+        assert_equal([res["result"] for res in results[29:]], [tip] * 5)
+
     def test_http_status_codes(self):
         self.log.info("Testing HTTP status codes for JSON-RPC requests...")
 
         expect_http_status(404, -32601, self.nodes[0].invalidmethod)
         expect_http_status(500, -8, self.nodes[0].getblockhash, 42)
 
+    def test_getrpcstats(self):
+        self.log.info("Testing getrpcstats...")
+
+        node = self.nodes[0]
+        calls_before = node.getrpcstats()['methods'].get('getblockhash', {'calls': 0, 'errors': 0})
+        node.getblockhash(0)
+        assert_raises_rpc_error(-8, "Block height out of range", node.getblockhash, 1000)
+
+        stats = node.getrpcstats()
+        assert_equal(set(stats['work_queue'].keys()), {'depth', 'max_depth', 'rejected'})
+        getblockhash = stats['methods']['getblockhash']
+        assert_equal(getblockhash['calls'], calls_before['calls'] + 2)
+        assert_equal(getblockhash['errors'], calls_before['errors'] + 1)
+        assert_equal(getblockhash['in_flight'], 0)
+        assert_greater_than_or_equal(getblockhash['max'], getblockhash['p99'])
+        assert_greater_than_or_equal(getblockhash['p99'], getblockhash['p50'])
+        assert_equal(stats['methods']['getrpcstats']['in_flight'], 1)
+
+    def test_fast_work_queue(self):
+        self.log.info("Testing the fast work queue...")
+
+        node = self.nodes[0]
+        assert_equal(node.getrpcstats()['fast_work_queue']['max_depth'], 16)
+        height = node.getblockcount()
+
+        self.restart_node(0, extra_args=['-rpcfastthreads=2', '-rpcfastworkqueue=4', '-rpcfastmethods=getblockcount,getrpcstats'])
+        node = self.nodes[0]
+        assert_equal(node.getblockcount(), height)
+        # Methods outside of the allowlist and batches still go to the default work queue
+        assert_equal(node.getbestblockhash(), node.getblockhash(height))
+        assert_equal(node.batch([node.getblockcount.get_request()])[0]['result'], height)
+        stats = node.getrpcstats()
+        assert_equal(stats['fast_work_queue']['max_depth'], 4)
+        assert_equal(stats['fast_work_queue']['rejected'], 0)
+
+        # Without fast worker threads all calls are served from the default work queue
+        self.restart_node(0, extra_args=['-rpcfastthreads=0'])
+        assert_equal(self.nodes[0].getblockcount(), height)
+
+    def test_fast_work_queue_saturated(self):
+        self.log.info("Testing the fast work queue while the default work queue is full...")
+
+        # generatetoaddress is only made fast here to release the blocked calls
+        self.restart_node(0, extra_args=['-rpcthreads=1', '-rpcworkqueue=1', '-rpcfastmethods=getblockcount,getrpcstats,generatetoaddress'])
+        node = self.nodes[0]
+        address = node.get_deterministic_priv_key().address
+        height = node.getblockcount()
+
+        def in_flight(method):
+            return node.getrpcstats()['methods'].get(method, {'in_flight': 0})['in_flight']
+
+        # One waitfornewblock call blocks the only worker thread, a second one fills the work queue
+        threads = [WaitForNewBlockThread(node) for _ in range(2)]
+        threads[0].start()
+        wait_until(lambda: in_flight('waitfornewblock') == 1)
+        threads[1].start()
+        wait_until(lambda: node.getrpcstats()['work_queue']['depth'] == 1)
+
+        # Other calls are rejected, but the fast methods still answer
+        expect_http_status(500, -342, node.getbestblockhash)
+        assert_equal(node.getrpcstats()['work_queue']['rejected'], 1)
+        assert_equal(node.getblockcount(), height)
+
+        for i, thread in enumerate(threads):
+            wait_until(lambda: in_flight('waitfornewblock') == 1)
+            node.generatetoaddress(1, address)
+            thread.join()
+            assert_equal(thread.result['height'], height + i + 1)
+        assert_equal(node.getbestblockhash(), node.getblockhash(height + 2))
+
     def run_test(self):
         self.test_getrpcinfo()
         self.test_batch_request()
+        self.test_parallel_batch_request()
         self.test_http_status_codes()
+        self.test_getrpcstats()
+        self.test_fast_work_queue()
+        self.test_fast_work_queue_saturated()
 
 
 if __name__ == '__main__':
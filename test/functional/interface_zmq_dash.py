@@ -413,7 +413,10 @@ class DashZMQTest (DashTestFramework):
 
     def test_getzmqnotifications(self):
         # Test getzmqnotifications RPC
-        assert_equal(self.nodes[0].getzmqnotifications(), [
+        notifications = self.nodes[0].getzmqnotifications()
+        for notification in notifications:
+            assert notification.pop("sent") >= 0
+        assert_equal(notifications, [
             {"type": "pubhashchainlock", "address": self.address, "hwm": 1000},
             {"type": "pubhashgovernanceobject", "address": self.address, "hwm": 1000},
             {"type": "pubhashgovernancevote", "address": self.address, "hwm": 1000},
@@ -58,6 +58,7 @@ class BlockchainTest(BitcoinTestFramework):
         self._test_getchaintxstats()
         self._test_gettxoutsetinfo()
         self._test_getblockheader()
+        self._test_getblock()
         self._test_getdifficulty()
         self._test_getnetworkhashps()
         self._test_stopatheight()
@@ -115,6 +116,22 @@ class BlockchainTest(BitcoinTestFramework):
         assert_equal(res['prune_target_size'], 576716800)
         assert_greater_than(res['size_on_disk'], 0)
 
+        # the cached status must follow tip changes right away
+        node = self.nodes[0]
+        tip = node.getbestblockhash()
+        height = node.getblockcount()
+        node.invalidateblock(tip)
+        res = node.getblockchaininfo()
+        assert_equal(res['blocks'], height - 1)
+        assert_equal(res['bestblockhash'], node.getblockheader(tip)['previousblockhash'])
+        assert_equal(node.getmininginfo()['blocks'], height - 1)
+        node.reconsiderblock(tip)
+        res = node.getblockchaininfo()
+        assert_equal(res['blocks'], height)
+        assert_equal(res['bestblockhash'], tip)
+        assert_equal(res['headers'], height)
+        assert_equal(node.getmininginfo()['blocks'], height)
+
     def _test_getchaintxstats(self):
         self.log.info("Test getchaintxstats")
 
@@ -238,6 +255,25 @@ class BlockchainTest(BitcoinTestFramework):
         header.calc_sha256()
         assert_equal(header.hash, besthash)
 
+    def _test_getblock(self):
+        node = self.nodes[0]
+
+        besthash = node.getbestblockhash()
+        block = node.getblock(besthash, 2)
+        assert_equal(block['hash'], besthash)
+        assert_equal(len(block['tx']), block['nTx'])
+        assert_equal([tx['txid'] for tx in block['tx']], node.getblock(besthash, 1)['tx'])
+        for tx in block['tx']:
+            assert 'instantlock' in tx
+            assert 'instantlock_internal' in tx
+
+        # Decoded transactions are memoized, repeated and batched calls must return the same result
+        assert_equal(node.getblock(besthash, 2), block)
+        results = node.batch([node.getblock.get_request(besthash, 2) for _ in range(4)])
+        for result in results:
+            assert_equal(result['error'], None)
+            assert_equal(result['result'], block)
+
     def _test_getdifficulty(self):
         difficulty = self.nodes[0].getdifficulty()
         # 1 hash in 2 should be valid, so difficulty should be 1/2**31
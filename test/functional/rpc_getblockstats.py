@@ -44,8 +44,8 @@ class GetblockstatsTest(BitcoinTestFramework):
 
     # def set_test_params(self):
     def set_test_params(self):
-        self.num_nodes = 2
-        self.extra_args = [['-txindex'], ['-txindex=0', '-paytxfee=0.003']]
+        self.num_nodes = 3
+        self.extra_args = [['-txindex'], ['-txindex=0', '-paytxfee=0.003'], ['-txindex=0', '-blockstatsindex']]
         self.setup_clean_chain = True
 
     def get_stats(self):
@@ -93,6 +93,7 @@ class GetblockstatsTest(BitcoinTestFramework):
         # Set the timestamps from the file so that the nodes can get out of Initial Block Download
         self.nodes[0].setmocktime(self.mocktime)
         self.nodes[1].setmocktime(self.mocktime)
+        self.nodes[2].setmocktime(self.mocktime)
 
         for b in blocks:
             self.nodes[0].submitblock(b)
@@ -130,6 +131,10 @@ class GetblockstatsTest(BitcoinTestFramework):
             stats_no_txindex = self.nodes[1].getblockstats(hash_or_height=blockhash, stats=list(expected_stats_noindex[i].keys()))
             assert_equal(stats_no_txindex, expected_stats_noindex[i])
 
+            # Check with the node that reads all stats from the block stats index
+            stats_blockstatsindex = self.nodes[2].getblockstats(hash_or_height=blockhash)
+            assert_equal(stats_blockstatsindex, self.expected_stats[i])
+
         # Make sure each stat can be queried on its own
         for stat in expected_keys:
             for i in range(self.max_stat_pos+1):
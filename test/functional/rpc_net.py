@@ -127,6 +127,12 @@ class NetTest(DashTestFramework):
         for info in network_info:
             assert_net_servicesnames(int(info["localservices"], 16), info["localservicesnames"])
 
+        # check the `blockcache` field
+        for info in network_info:
+            block_cache = info["blockcache"]
+            assert_equal(block_cache["maxbytes"], 32 * 1024 * 1024)
+            assert block_cache["bytes"] <= block_cache["maxbytes"]
+
         self.log.info('Test extended connections info')
         connect_nodes(self.nodes[1], 2)
         self.nodes[1].ping()
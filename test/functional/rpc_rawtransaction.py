@@ -19,6 +19,7 @@ from test_framework.messages import CTransaction, ToHex
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.util import (
     assert_equal,
+    assert_greater_than,
     assert_raises_rpc_error,
     connect_nodes,
     hex_str_to_bytes,
@@ -392,6 +393,26 @@ class RawTransactionsTest(BitcoinTestFramework):
         assert_equal(testres['allowed'], True)
         self.nodes[2].sendrawtransaction(hexstring=rawTxSigned['hex'], maxfeerate=0.00007000)
 
+        self.log.info('getblock verbosity 2 matches getrawtransaction for a block decoded in parallel')
+
+        # Blocks with at least 16 transactions are decoded on the RPC thread pool
+        address = self.nodes[2].getnewaddress()
+        txids = [self.nodes[0].sendtoaddress(address, 0.1) for _ in range(20)]
+        self.sync_all()
+        blockhash = self.nodes[0].generate(1)[0]
+        self.sync_all()
+        block = self.nodes[0].getblock(blockhash, 2)
+        assert_greater_than(len(block['tx']), len(txids))
+        assert set(txids) <= set(tx['txid'] for tx in block['tx'])
+        for tx in block['tx']:
+            rawTx = self.nodes[0].getrawtransaction(tx['txid'], 1)
+            assert_equal(tx, {key: rawTx[key] for key in tx})
+        # The decoded transactions are memoized, batched calls wait for the same decoding
+        assert_equal(self.nodes[0].getblock(blockhash, 2), block)
+        for res in self.nodes[0].batch([self.nodes[0].getblock.get_request(blockhash, 2) for _ in range(4)]):
+            assert_equal(res['error'], None)
+            assert_equal(res['result'], block)
+
 
 if __name__ == '__main__':
     RawTransactionsTest().main()
@@ -216,6 +216,7 @@ BASE_SCRIPTS = [
     'rpc_mnauth.py',
     'rpc_verifyislock.py',
     'rpc_verifychainlock.py',
+    'interface_rest_dash.py',
     'wallet_create_tx.py',
     'p2p_fingerprint.py',
     'rpc_platform_filter.py',